@@ -231,6 +231,14 @@ typedef struct MDS_MsgList {
 
 size_t MDS_MsgListGetLength(const MDS_MsgList_t *msg);
 size_t MDS_MsgListCopyBuff(void *buff, size_t size, const MDS_MsgList_t *msg);
+size_t MDS_MsgListReadBuff(void *buff, size_t size, const MDS_MsgList_t *msg, size_t offset);
+int MDS_MsgListCmpBuff(const MDS_MsgList_t *msg, size_t offset, const void *buff, size_t len);
+size_t MDS_MsgListCopyList(const MDS_MsgList_t *dst, const MDS_MsgList_t *src);
+size_t MDS_MsgListSlice(MDS_MsgList_t *slice, size_t count, const MDS_MsgList_t *msg,
+                        size_t offset, size_t len);
+uint32_t MDS_MsgListCrc32(uint32_t crc, const MDS_MsgList_t *msg);
+uint16_t MDS_MsgListCrc16(uint16_t crc, const MDS_MsgList_t *msg);
+uint16_t MDS_MsgListInetChecksum(const MDS_MsgList_t *msg);
 
 /* Memory ------------------------------------------------------------------ */
 bool MDS_MemAddrIsAligned(const void *address, uintptr_t align);
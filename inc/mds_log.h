@@ -41,6 +41,14 @@ extern "C" {
 #define CONFIG_MDS_LOG_FORMAT_SECTION ".logfmt."
 #endif
 
+#ifndef CONFIG_MDS_LOG_MODULE_SECTION
+#define CONFIG_MDS_LOG_MODULE_SECTION ".logmod."
+#endif
+
+#ifndef CONFIG_MDS_LOG_COMPRESS_ENABLE
+#define CONFIG_MDS_LOG_COMPRESS_ENABLE 0
+#endif
+
 /* Log --------------------------------------------------------------------- */
 #define MDS_LOG_LEVEL_OFF 0
 #define MDS_LOG_LEVEL_FAT 1
@@ -55,12 +63,19 @@ typedef void (*MDS_LOG_VaPrint_t)(const MDS_LOG_Module_t *module, uint8_t level,
 
 typedef struct MDS_LOG_Filter {
     MDS_LOG_VaPrint_t backend;
-    uint8_t level;  // align ?
+
+    // token bucket of async backend
+    uint16_t rate;  // messages per second, zero as unlimited
+    uint16_t burst;
+    uint16_t tokens;
+    MDS_Tick_t tick;
+    size_t dropped;
 } MDS_LOG_Filter_t;
 
 struct MDS_LOG_Module {
     const char *name;
 #if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
+    uint8_t level;  // runtime level, checked at the call site
     MDS_LOG_Filter_t *filter;
 #endif
 };
@@ -77,29 +92,49 @@ struct MDS_LOG_Module {
 
 #define __LOG_MODULE_LEVEL(...) MDS_ARGUMENT_GET_N(1, ##__VA_ARGS__, CONFIG_MDS_LOG_BUILD_LEVEL)
 
+#if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
 #define MDS_LOG_MODULE_DECLARE(_name, ...)                                                        \
     static __attribute__((used))                                                                  \
     const uint8_t __THIS_LOG_MODULE_LEVEL = __LOG_MODULE_LEVEL(__VA_ARGS__);                      \
-    extern const MDS_LOG_Module_t G_MDS_LOG_MODULE_##_name;                                       \
+    extern MDS_LOG_Module_t G_MDS_LOG_MODULE_##_name;                                             \
     static __attribute__((used))                                                                  \
-    const MDS_LOG_Module_t *const __THIS_LOG_MODULE_HANDLE = &(G_MDS_LOG_MODULE_##_name)
+    MDS_LOG_Module_t *const __THIS_LOG_MODULE_HANDLE = &(G_MDS_LOG_MODULE_##_name)
 
-#if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
 #define MDS_LOG_MODULE_DEFINE(_name, ...)                                                         \
     static __attribute__((used))                                                                  \
     const uint8_t __THIS_LOG_MODULE_LEVEL = __LOG_MODULE_LEVEL(__VA_ARGS__);                      \
     static MDS_LOG_Filter_t g_mds_log_filter_##_name = {                                          \
-        .level = __LOG_MODULE_LEVEL(__VA_ARGS__),                                                 \
         .backend = NULL,                                                                          \
     };                                                                                            \
-    const MDS_LOG_Module_t G_MDS_LOG_MODULE_##_name = {                                           \
-        .name = #_name, .filter = &(g_mds_log_filter_##_name)};                                   \
+    MDS_LOG_Module_t G_MDS_LOG_MODULE_##_name = {                                                 \
+        .name = #_name,                                                                           \
+        .level = __LOG_MODULE_LEVEL(__VA_ARGS__),                                                 \
+        .filter = &(g_mds_log_filter_##_name),                                                    \
+    };                                                                                            \
+    static __attribute__((used, section(CONFIG_MDS_LOG_MODULE_SECTION #_name)))                   \
+    MDS_LOG_Module_t *const __MDS_LOG_MODULE_##_name = &(G_MDS_LOG_MODULE_##_name);               \
     static __attribute__((used))                                                                  \
-    const MDS_LOG_Module_t *const __THIS_LOG_MODULE_HANDLE = &(G_MDS_LOG_MODULE_##_name)
+    MDS_LOG_Module_t *const __THIS_LOG_MODULE_HANDLE = &(G_MDS_LOG_MODULE_##_name)
+
+#define __LOG_MODULE_ENABLED(_lvl)                                                                \
+    ((_lvl <= __THIS_LOG_MODULE_LEVEL) && (_lvl <= __THIS_LOG_MODULE_HANDLE->level))
 
-#define MDS_LOG_MODULE_LEVEL(_lvl)       __THIS_LOG_MODULE_HANDLE->filter->level = _lvl
+#define MDS_LOG_MODULE_LEVEL(_lvl)       __THIS_LOG_MODULE_HANDLE->level = _lvl
 #define MDS_LOG_MODULE_BACKEND(_backend) __THIS_LOG_MODULE_HANDLE->filter->backend = _backend
+#define MDS_LOG_MODULE_RATELIMIT(_rate, _burst)                                                   \
+    do {                                                                                          \
+        __THIS_LOG_MODULE_HANDLE->filter->rate = _rate;                                           \
+        __THIS_LOG_MODULE_HANDLE->filter->burst = _burst;                                         \
+        __THIS_LOG_MODULE_HANDLE->filter->tokens = _burst;                                        \
+    } while (0)
 #else
+#define MDS_LOG_MODULE_DECLARE(_name, ...)                                                        \
+    static __attribute__((used))                                                                  \
+    const uint8_t __THIS_LOG_MODULE_LEVEL = __LOG_MODULE_LEVEL(__VA_ARGS__);                      \
+    extern const MDS_LOG_Module_t G_MDS_LOG_MODULE_##_name;                                       \
+    static __attribute__((used))                                                                  \
+    const MDS_LOG_Module_t *const __THIS_LOG_MODULE_HANDLE = &(G_MDS_LOG_MODULE_##_name)
+
 #define MDS_LOG_MODULE_DEFINE(_name, ...)                                                         \
     static __attribute__((used))                                                                  \
     const uint8_t __THIS_LOG_MODULE_LEVEL = __LOG_MODULE_LEVEL(__VA_ARGS__);                      \
@@ -107,8 +142,11 @@ struct MDS_LOG_Module {
     static __attribute__((used))                                                                  \
     const MDS_LOG_Module_t *const __THIS_LOG_MODULE_HANDLE = &(G_MDS_LOG_MODULE_##_name)
 
-#define MDS_LOG_MODULE_LEVEL(_lvl)       (void)(__THIS_LOG_MODULE_LEVEL)
-#define MDS_LOG_MODULE_BACKEND(_backend) (void)(__THIS_LOG_MODULE_LEVEL)
+#define __LOG_MODULE_ENABLED(_lvl) (_lvl <= __THIS_LOG_MODULE_LEVEL)
+
+#define MDS_LOG_MODULE_LEVEL(_lvl)              (void)(__THIS_LOG_MODULE_LEVEL)
+#define MDS_LOG_MODULE_BACKEND(_backend)        (void)(__THIS_LOG_MODULE_LEVEL)
+#define MDS_LOG_MODULE_RATELIMIT(_rate, _burst) (void)(__THIS_LOG_MODULE_LEVEL)
 #endif
 
 #define __LOG_ARGSIZE_INDEX(idx, x, ...)                                                          \
@@ -125,7 +163,7 @@ struct MDS_LOG_Module {
         unsigned long: sizeof(unsigned long),                                                     \
         long long: sizeof(long long),                                                             \
         unsigned long long: sizeof(unsigned long long),                                           \
-        float: sizeof(float),                                                                     \
+        float: sizeof(double),                                                                    \
         double: sizeof(double),                                                                   \
         long double: sizeof(long double),                                                         \
         default: sizeof(void *))
@@ -133,10 +171,48 @@ struct MDS_LOG_Module {
 #define __LOG_ARGUMENT_SIZE(...)                                                                  \
     (0 + MDS_ARGUMENT_FOREACH_N(__LOG_ARGSIZE_INDEX, (+), 0, ##__VA_ARGS__))
 
-#if (defined(CONFIG_MDS_LOG_ENABLE) && (CONFIG_MDS_LOG_ENABLE != 0))
+#define __LOG_ARGPACK_INDEX(idx, x, _pos)                                                         \
+    (_pos) = _Generic((x),                                                                        \
+        bool: MDS_LOG_PackInt,                                                                    \
+        char: MDS_LOG_PackInt,                                                                    \
+        signed char: MDS_LOG_PackInt,                                                             \
+        unsigned char: MDS_LOG_PackInt,                                                           \
+        short: MDS_LOG_PackInt,                                                                   \
+        unsigned short: MDS_LOG_PackInt,                                                          \
+        int: MDS_LOG_PackInt,                                                                     \
+        unsigned int: MDS_LOG_PackInt,                                                            \
+        long: MDS_LOG_PackLong,                                                                   \
+        unsigned long: MDS_LOG_PackLong,                                                          \
+        long long: MDS_LOG_PackLongLong,                                                          \
+        unsigned long long: MDS_LOG_PackLongLong,                                                 \
+        float: MDS_LOG_PackDouble,                                                                \
+        double: MDS_LOG_PackDouble,                                                               \
+        long double: MDS_LOG_PackLongDouble,                                                      \
+        default: MDS_LOG_PackPointer)((_pos), (x))
+
+// raw argument bytes in vararg promotion, evaluates to the end of packed arguments
+#define __LOG_ARGUMENT_PACK(_pos, ...)                                                            \
+    (MDS_ARGUMENT_FOREACH_N(__LOG_ARGPACK_INDEX, (, ), _pos, ##__VA_ARGS__))
+
+#if (defined(CONFIG_MDS_LOG_ENABLE) && (CONFIG_MDS_LOG_ENABLE != 0)) &&                           \
+    (defined(CONFIG_MDS_LOG_COMPRESS_ENABLE) && (CONFIG_MDS_LOG_COMPRESS_ENABLE != 0))
+#define MDS_LOG_PRINT(_lvl, _fmt, ...)                                                            \
+    do {                                                                                          \
+        if (__LOG_MODULE_ENABLED(_lvl)) {                                                         \
+            static __attribute__((section(__LOG_FORMAT_SECTION_STR(_lvl))))                       \
+            const char __logfmt[] = _fmt "\n";                                                    \
+            uint8_t __logargs[__LOG_ARGUMENT_SIZE(__VA_ARGS__) + 1];                              \
+            uint8_t *__logpos = __logargs;                                                        \
+            size_t __logsize =                                                                    \
+                (size_t)(__LOG_ARGUMENT_PACK(__logpos, ##__VA_ARGS__) - __logargs);               \
+            MDS_LOG_CompressWrite(__THIS_LOG_MODULE_HANDLE, _lvl, __logfmt,                       \
+                                  (__logsize != 0) ? (__logargs) : (NULL), __logsize);            \
+        }                                                                                         \
+    } while (0)
+#elif (defined(CONFIG_MDS_LOG_ENABLE) && (CONFIG_MDS_LOG_ENABLE != 0))
 #define MDS_LOG_PRINT(_lvl, _fmt, ...)                                                            \
     do {                                                                                          \
-        if (_lvl <= __THIS_LOG_MODULE_LEVEL) {                                                    \
+        if (__LOG_MODULE_ENABLED(_lvl)) {                                                         \
             static __attribute__((section(__LOG_FORMAT_SECTION_STR(_lvl))))                       \
             const char __logfmt[] = _fmt "\n";                                                    \
             MDS_LOG_ModulePrintf(__THIS_LOG_MODULE_HANDLE, _lvl,                                  \
@@ -160,6 +236,13 @@ struct MDS_LOG_Module {
 /* Function ---------------------------------------------------------------- */
 void MDS_LOG_RegisterVaPrint(MDS_LOG_VaPrint_t logVaPrint);
 
+#if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
+MDS_LOG_Module_t *MDS_LOG_ModuleFind(const char *name);
+void MDS_LOG_ModuleForeach(void (*entry)(MDS_LOG_Module_t *module, MDS_Arg_t *arg),
+                           MDS_Arg_t *arg);
+MDS_Err_t MDS_LOG_ModuleSetLevel(const char *name, uint8_t level);
+#endif
+
 __attribute__((format(printf, 4, 5))) void MDS_LOG_ModulePrintf(const MDS_LOG_Module_t *module,
                                                                 uint8_t level, size_t va_size,
                                                                 const char *fmt, ...);
@@ -214,20 +297,63 @@ __attribute__((noreturn, format(printf, 2, 3))) void MDS_PanicPrintf(size_t va_s
                     ())
 
 /* Compress ---------------------------------------------------------------- */
+/*
+ * Deferred log record, only the format address and raw arguments are kept.
+ * Records are read out by MDS_LOG_CompressRead() and formatted on the host
+ * with tools/mds_logfmt.py against the `.logfmt.` sections of the elf.
+ */
+#define MDS_LOG_COMPRESS_MAGIC 0xD6
+
 typedef struct MDS_LOG_Compress {
-    uint32_t magic     : 8;
-    uint32_t address   : 24;  // 0xFFxxxxxx
-    uint32_t level     : 4;
-    uint32_t count     : 4;
-    uint32_t psn       : 12;
-    uint64_t timestamp : 44;  // ms
-    uint32_t args[0];
+    uint32_t magic   : 8;
+    uint32_t level   : 4;
+    uint32_t psn     : 12;
+    uint32_t size    : 8;  // bytes of args
+    uint32_t address;      // format string in .logfmt section
+    uint32_t timestamp;    // tick
+    uint8_t args[0];
 } MDS_LOG_Compress_t;
 
-size_t MDS_LOG_CompressStructVa(MDS_LOG_Compress_t *log, size_t level, size_t cnt, const char *fmt,
-                                va_list ap);
-size_t MDS_LOG_CompressSturctPrint(MDS_LOG_Compress_t *log, size_t level, size_t cnt,
-                                   const char *fmt, ...);
+static inline uint8_t *MDS_LOG_PackInt(uint8_t *pos, int val)
+{
+    __builtin_memcpy(pos, &val, sizeof(val));
+    return (pos + sizeof(val));
+}
+
+static inline uint8_t *MDS_LOG_PackLong(uint8_t *pos, long val)
+{
+    __builtin_memcpy(pos, &val, sizeof(val));
+    return (pos + sizeof(val));
+}
+
+static inline uint8_t *MDS_LOG_PackLongLong(uint8_t *pos, long long val)
+{
+    __builtin_memcpy(pos, &val, sizeof(val));
+    return (pos + sizeof(val));
+}
+
+static inline uint8_t *MDS_LOG_PackDouble(uint8_t *pos, double val)
+{
+    __builtin_memcpy(pos, &val, sizeof(val));
+    return (pos + sizeof(val));
+}
+
+static inline uint8_t *MDS_LOG_PackLongDouble(uint8_t *pos, long double val)
+{
+    __builtin_memcpy(pos, &val, sizeof(val));
+    return (pos + sizeof(val));
+}
+
+static inline uint8_t *MDS_LOG_PackPointer(uint8_t *pos, const void *val)
+{
+    __builtin_memcpy(pos, &val, sizeof(val));
+    return (pos + sizeof(val));
+}
+
+void MDS_LOG_CompressWrite(const MDS_LOG_Module_t *module, uint8_t level, const char *fmt,
+                           const void *args, size_t size);
+size_t MDS_LOG_CompressRead(void *buff, size_t size);
+size_t MDS_LOG_CompressDropped(void);
 
 #ifdef __cplusplus
 }
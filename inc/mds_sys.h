@@ -140,15 +140,63 @@ MDS_Lock_t MDS_CriticalLock(MDS_SpinLock_t *spinlock);
 void MDS_CriticalRestore(MDS_SpinLock_t *spinlock, MDS_Lock_t lock);
 void MDS_SpinLockInit(MDS_SpinLock_t *spinlock);
 
+/* Atomic ------------------------------------------------------------------ */
+typedef volatile intptr_t MDS_Atomic_t;
+
+static inline intptr_t MDS_AtomicLoad(const MDS_Atomic_t *atomic)
+{
+    return (__atomic_load_n(atomic, __ATOMIC_ACQUIRE));
+}
+
+static inline void MDS_AtomicStore(MDS_Atomic_t *atomic, intptr_t value)
+{
+    __atomic_store_n(atomic, value, __ATOMIC_RELEASE);
+}
+
+static inline bool MDS_AtomicCompareExchange(MDS_Atomic_t *atomic, intptr_t *expect,
+                                             intptr_t desired)
+{
+    if (__atomic_always_lock_free(sizeof(*atomic), 0)) {
+        return (__atomic_compare_exchange_n(atomic, expect, desired, false, __ATOMIC_ACQ_REL,
+                                            __ATOMIC_ACQUIRE));
+    }
+
+    // core without exclusive access instructions (armv6-m), fall back to interrupt lock
+    bool success = false;
+    MDS_Lock_t lock = MDS_CriticalLock(NULL);
+    if (*atomic == *expect) {
+        *atomic = desired;
+        success = true;
+    } else {
+        *expect = *atomic;
+    }
+    MDS_CriticalRestore(NULL, lock);
+
+    return (success);
+}
+
+static inline intptr_t MDS_AtomicFetchAdd(MDS_Atomic_t *atomic, intptr_t value)
+{
+    intptr_t expect = MDS_AtomicLoad(atomic);
+
+    while (!MDS_AtomicCompareExchange(atomic, &expect, expect + value)) {
+    }
+
+    return (expect);
+}
+
 /* Object ------------------------------------------------------------------ */
 typedef enum MDS_ObjectType {
     MDS_OBJECT_TYPE_NONE = 0,
     MDS_OBJECT_TYPE_DEVICE,
     MDS_OBJECT_TYPE_THREAD,
+    MDS_OBJECT_TYPE_THREADPOOL,
     MDS_OBJECT_TYPE_WORKQUEUE,
     MDS_OBJECT_TYPE_WORKNODE,
     MDS_OBJECT_TYPE_SEMAPHORE,
+    MDS_OBJECT_TYPE_CONDITION,
     MDS_OBJECT_TYPE_MUTEX,
+    MDS_OBJECT_TYPE_RWLOCK,
     MDS_OBJECT_TYPE_EVENT,
     MDS_OBJECT_TYPE_POLL,
     MDS_OBJECT_TYPE_MSGQUEUE,
@@ -192,15 +240,24 @@ MDS_ObjectType_t MDS_ObjectGetType(const MDS_Object_t *object);
 bool MDS_ObjectIsCreated(const MDS_Object_t *object);
 
 /* Kernel ------------------------------------------------------------------ */
-typedef union MDS_WaitQueue {
-    MDS_DListNode_t list;
-    MDS_DListNode_t node;
-} MDS_WaitQueue_t;
-
 typedef struct MDS_ThreadPriority {
     int8_t priority;
 } __attribute__((packed)) MDS_ThreadPriority_t;
 
+typedef struct MDS_WaitQueue {
+    MDS_DListNode_t list;
+#if (CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX > 0)
+    uint32_t prioMask;
+    MDS_DListNode_t *prioHead[CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX];  // first waiter of priority
+#endif
+} MDS_WaitQueue_t;
+
+typedef struct MDS_WaitNode {
+    MDS_DListNode_t node;
+    MDS_WaitQueue_t *queue;         // wait queue pending on, NULL on ready list
+    MDS_ThreadPriority_t priority;  // priority bucket queued in
+} MDS_WaitNode_t;
+
 void MDS_KernelInit(void);
 void MDS_KernelStartup(void);
 MDS_Thread_t *MDS_KernelCurrentThread(void);
@@ -208,16 +265,39 @@ MDS_Tick_t MDS_KernelGetSleepTick(void);
 void MDS_KernelCompensateTick(MDS_Tick_t ticks);
 void MDS_KernelSchdulerLockAcquire(void);
 void MDS_KernelSchdulerLockRelease(void);
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+size_t MDS_KernelGetCpuLoad(void);
+#endif
 
 /* WorkQueue --------------------------------------------------------------- */
 typedef void (*MDS_WorkEntry_t)(const MDS_WorkNode_t *workn, MDS_Arg_t *arg);
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+typedef struct MDS_WorkQueueStats {
+    size_t executed;        // count of work entries run
+    size_t coalesced;       // wakeups saved by slack
+    MDS_Tick_t latencySum;  // ticks from due to dispatch
+    MDS_Tick_t latencyMax;
+    MDS_Tick_t runSum;  // ticks spent in work entries
+    MDS_Tick_t runMax;
+} MDS_WorkQueueStats_t;
+#endif
+
 struct MDS_WorkQueue {
     MDS_Object_t object;
 
     MDS_Thread_t *thread;
+    MDS_Thread_t **workers;
+    size_t nworkers;
+    MDS_WaitQueue_t queueIdle;  // workers waiting for the next due work
+    MDS_DListNode_t listReady;  // fifo of works submitted without delay
+    MDS_DListNode_t listRun;    // entries being executed by workers
     MDS_DListNode_t list[CONFIG_MDS_TIMER_SKIPLIST_LEVEL];
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+    MDS_WorkQueueStats_t stats;
+#endif
+
     MDS_SpinLock_t spinlock;
 };
 
@@ -228,6 +308,10 @@ struct MDS_WorkNode {
     MDS_WorkQueue_t *queue;
     MDS_Tick_t tickout;
     MDS_Tick_t tperiod;
+    MDS_Tick_t tslack;  // ticks the expiry may be deferred to join another
+    uint8_t concurrency;  // workers allowed to run entry at once
+    uint8_t running;
+    bool pending;  // due while at concurrency limit
 
     // callback
     MDS_WorkEntry_t entry;
@@ -241,10 +325,15 @@ MDS_Err_t MDS_WorkQueueInit(MDS_WorkQueue_t *workq, const char *name, MDS_Thread
 MDS_Err_t MDS_WorkQueueDeInit(MDS_WorkQueue_t *workq);
 MDS_WorkQueue_t *MDS_WorkQueueCreate(const char *name, size_t stackSize,
                                      MDS_ThreadPriority_t priority, MDS_Timeout_t timeout);
+MDS_WorkQueue_t *MDS_WorkQueueCreatePool(const char *name, size_t nthreads, size_t stackSize,
+                                         MDS_ThreadPriority_t priority, MDS_Timeout_t timeout);
 MDS_Err_t MDS_WorkQueueDestroy(MDS_WorkQueue_t *workq);
 MDS_Err_t MDS_WorkQueueStart(MDS_WorkQueue_t *workq);
 MDS_Err_t MDS_WorkQueueStop(MDS_WorkQueue_t *workq);
 MDS_Tick_t MDS_WorkQueueNextTick(MDS_WorkQueue_t *workq);
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+void MDS_WorkQueueGetStats(MDS_WorkQueue_t *workq, MDS_WorkQueueStats_t *stats);
+#endif
 
 MDS_Err_t MDS_WorkNodeInit(MDS_WorkNode_t *workn, const char *name, MDS_WorkEntry_t entry,
                            MDS_WorkEntry_t stop, MDS_Arg_t *arg);
@@ -254,6 +343,8 @@ MDS_WorkNode_t *MDS_WorkNodeCreate(const char *name, MDS_WorkEntry_t entry, MDS_
 MDS_Err_t MDS_WorkNodeDestroy(MDS_WorkNode_t *workn);
 MDS_Err_t MDS_WorkNodeSubmit(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn, MDS_Timeout_t delay,
                              MDS_Timeout_t period);
+MDS_Err_t MDS_WorkNodeSetConcurrency(MDS_WorkNode_t *workn, uint8_t concurrency);
+MDS_Err_t MDS_WorkNodeSetSlack(MDS_WorkNode_t *workn, MDS_Timeout_t slack);
 MDS_Err_t MDS_WorkNodeCancle(MDS_WorkNode_t *workn);
 bool MDS_WorkNodeIsSubmit(const MDS_WorkNode_t *workn);
 
@@ -268,7 +359,109 @@ MDS_Timer_t *MDS_TimerCreate(const char *name, MDS_TimerEntry_t entry, MDS_Timer
 MDS_Err_t MDS_TimerDestroy(MDS_Timer_t *timer);
 MDS_Err_t MDS_TimerStart(MDS_Timer_t *timer, MDS_Timeout_t duration, MDS_Timeout_t period);
 MDS_Err_t MDS_TimerStop(MDS_Timer_t *timer);
+MDS_Err_t MDS_TimerSetSlack(MDS_Timer_t *timer, MDS_Timeout_t slack);
 bool MDS_TimerIsActive(const MDS_Timer_t *timer);
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+void MDS_TimerGetStats(MDS_WorkQueueStats_t *stats);
+#endif
+
+/* Async ------------------------------------------------------------------- */
+/*
+ * Stackless tasks resumed by a workqueue, every task shares the worker stack.
+ * Local variables are not kept across MDS_ASYNC_YIELD/MDS_ASYNC_AWAIT_*,
+ * keep the state in the task argument; `switch` can't be used around them.
+ */
+typedef struct MDS_Async MDS_Async_t;
+
+typedef enum MDS_AsyncState {
+    MDS_ASYNC_STATE_EXITED = 0,
+    MDS_ASYNC_STATE_WAITING,
+} MDS_AsyncState_t;
+
+typedef MDS_AsyncState_t (*MDS_AsyncEntry_t)(MDS_Async_t *async, MDS_Arg_t *arg);
+
+struct MDS_Async {
+    MDS_WorkNode_t workn;
+    MDS_WorkQueue_t *workq;
+
+    MDS_AsyncEntry_t entry;
+    MDS_Arg_t *arg;
+
+    MDS_Tick_t tickwait;  // await timeout
+    MDS_Tick_t tickout;   // await deadline
+    MDS_Err_t err;        // result of last await
+    uint16_t line;        // resume point
+    bool wakeup;          // woken since await began
+};
+
+MDS_Err_t MDS_AsyncInit(MDS_Async_t *async, const char *name, MDS_WorkQueue_t *workq,
+                        MDS_AsyncEntry_t entry, MDS_Arg_t *arg);
+MDS_Err_t MDS_AsyncDeInit(MDS_Async_t *async);
+MDS_Err_t MDS_AsyncStart(MDS_Async_t *async);
+MDS_Err_t MDS_AsyncStop(MDS_Async_t *async);
+MDS_Err_t MDS_AsyncWakeup(MDS_Async_t *async);
+bool MDS_AsyncIsRunning(const MDS_Async_t *async);
+
+MDS_AsyncState_t MDS_AsyncYield(MDS_Async_t *async);
+void MDS_AsyncAwaitBegin(MDS_Async_t *async, MDS_Timeout_t timeout);
+bool MDS_AsyncAwaitCheck(MDS_Async_t *async, MDS_Err_t err);
+bool MDS_AsyncDelayCheck(MDS_Async_t *async);
+
+#define MDS_ASYNC_BEGIN(async)                                                                    \
+    switch ((async)->line) {                                                                      \
+        case 0:
+
+#define MDS_ASYNC_END(async)                                                                      \
+    }                                                                                             \
+    (async)->line = 0;                                                                            \
+    return (MDS_ASYNC_STATE_EXITED)
+
+#define MDS_ASYNC_EXIT(async)                                                                     \
+    do {                                                                                          \
+        (async)->line = 0;                                                                        \
+        return (MDS_ASYNC_STATE_EXITED);                                                          \
+    } while (0)
+
+#define MDS_ASYNC_YIELD(async)                                                                    \
+    do {                                                                                          \
+        (async)->line = __LINE__;                                                                 \
+        return (MDS_AsyncYield(async));                                                           \
+        case __LINE__:;                                                                           \
+    } while (0)
+
+/* delay ends at `timeout` or early on MDS_AsyncWakeup, MDS_TIMEOUT_FOREVER waits for the wakeup */
+#define MDS_ASYNC_AWAIT_DELAY(async, timeout)                                                     \
+    do {                                                                                          \
+        MDS_AsyncAwaitBegin(async, timeout);                                                      \
+        (async)->line = __LINE__;                                                                 \
+        __attribute__((fallthrough));                                                             \
+        case __LINE__:                                                                            \
+            if (!MDS_AsyncDelayCheck(async)) {                                                    \
+                return (MDS_ASYNC_STATE_WAITING);                                                 \
+            }                                                                                     \
+    } while (0)
+
+/* `expr` returns MDS_ETIMEOUT while not ready, retried until `timeout`, result in (async)->err */
+#define MDS_ASYNC_AWAIT(async, expr, timeout)                                                     \
+    do {                                                                                          \
+        MDS_AsyncAwaitBegin(async, timeout);                                                      \
+        (async)->line = __LINE__;                                                                 \
+        __attribute__((fallthrough));                                                             \
+        case __LINE__:                                                                            \
+            if (!MDS_AsyncAwaitCheck(async, (expr))) {                                            \
+                return (MDS_ASYNC_STATE_WAITING);                                                 \
+            }                                                                                     \
+    } while (0)
+
+#define MDS_ASYNC_AWAIT_SEMAPHORE(async, semaphore, timeout)                                      \
+    MDS_ASYNC_AWAIT(async, MDS_SemaphoreAcquire(semaphore, MDS_TIMEOUT_NO_WAIT), timeout)
+
+#define MDS_ASYNC_AWAIT_EVENT(async, event, mask, opt, recv, timeout)                             \
+    MDS_ASYNC_AWAIT(async, MDS_EventWait(event, mask, opt, recv, MDS_TIMEOUT_NO_WAIT), timeout)
+
+#define MDS_ASYNC_AWAIT_MSGQUEUE(async, msgQueue, buff, size, timeout)                            \
+    MDS_ASYNC_AWAIT(async, MDS_MsgQueueRecvCopy(msgQueue, buff, size, MDS_TIMEOUT_NO_WAIT),      \
+                    timeout)
 
 /* Thread ------------------------------------------------------------------ */
 typedef void (*MDS_ThreadEntry_t)(MDS_Arg_t *arg);
@@ -283,6 +476,7 @@ typedef enum MDS_ThreadState {
     MDS_THREAD_STATE_SUSPENDED = 0x04U,
 
     MDS_THREAD_STATE_MASK = 0x0FU,
+    MDS_THREAD_FLAG_THROTTLE = 0x40U,
     MDS_THREAD_FLAG_YIELD = 0x80U,
 } __attribute__((packed)) MDS_ThreadState_t;
 
@@ -295,9 +489,18 @@ typedef enum MDS_EventOpt {
     MDS_EVENT_OPR_AND_NOCLR = MDS_EVENT_OPT_AND | MDS_EVENT_OPT_NOCLR,
 } __attribute__((packed)) MDS_EventOpt_t;
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+typedef struct MDS_ThreadStats {
+    uint64_t cycles;         // core cycles spent running
+    size_t switchIn;         // times switched to
+    size_t switchPreempt;    // switched out while still ready
+    size_t switchVoluntary;  // switched out by blocking, suspend or exit
+} MDS_ThreadStats_t;
+#endif
+
 struct MDS_Thread {
     MDS_Object_t object;
-    MDS_WaitQueue_t nodeWait;
+    MDS_WaitNode_t nodeWait;
 
     MDS_ThreadEntry_t entry;
     MDS_Arg_t *arg;
@@ -308,7 +511,8 @@ struct MDS_Thread {
 
     MDS_Tick_t initTick;
     MDS_Tick_t remainTick;
-    MDS_Timer_t timer;
+    MDS_Tick_t tickTimeout;
+    MDS_DListNode_t nodeTimeout;
 
     volatile MDS_Err_t err;
     MDS_ThreadPriority_t initPrio;
@@ -317,8 +521,29 @@ struct MDS_Thread {
     MDS_EventOpt_t eventOpt;
     MDS_Mask_t eventMask;
 
+    MDS_DListNode_t listHold;  // mutexes held by this thread
+    MDS_Mutex_t *mutexWait;    // mutex this thread is blocked on
+
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+    MDS_Tick_t edfPeriod;    // earliest deadline first in its priority when nonzero
+    MDS_Tick_t edfRelative;  // relative deadline
+    MDS_Tick_t edfRuntime;   // reserved runtime each period
+    MDS_Tick_t edfRelease;   // release tick of current job
+    MDS_Tick_t edfDeadline;  // absolute deadline of current job
+    size_t edfMissed;
+#endif
+
+#if (defined(CONFIG_MDS_KERNEL_BUDGET_ENABLE) && (CONFIG_MDS_KERNEL_BUDGET_ENABLE != 0))
+    MDS_Tick_t budgetInit;    // ticks allowed each period, zero as unlimited
+    MDS_Tick_t budgetPeriod;  // replenishment period
+    MDS_Tick_t budgetRemain;
+    MDS_Tick_t budgetRefill;  // tick of next replenishment
+    size_t budgetThrottled;
+#endif
+
 #if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
     void *stackWater;
+    MDS_ThreadStats_t stats;
 #endif
 
     MDS_SpinLock_t spinlock;
@@ -339,14 +564,64 @@ MDS_Err_t MDS_ThreadSetPriority(MDS_Thread_t *thread, MDS_ThreadPriority_t prior
 MDS_ThreadState_t MDS_ThreadGetState(const MDS_Thread_t *thread);
 MDS_Err_t MDS_ThreadDelay(MDS_Timeout_t timeout);
 MDS_Err_t MDS_ThreadYield(void);
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+MDS_Err_t MDS_ThreadSetDeadline(MDS_Thread_t *thread, MDS_Timeout_t period,
+                                MDS_Timeout_t deadline, MDS_Timeout_t runtime);
+MDS_Err_t MDS_ThreadWaitPeriod(void);
+size_t MDS_ThreadGetDeadlineMissed(const MDS_Thread_t *thread);
+#endif
+#if (defined(CONFIG_MDS_KERNEL_BUDGET_ENABLE) && (CONFIG_MDS_KERNEL_BUDGET_ENABLE != 0))
+MDS_Err_t MDS_ThreadSetBudget(MDS_Thread_t *thread, MDS_Timeout_t budget, MDS_Timeout_t period);
+MDS_Tick_t MDS_ThreadGetBudgetUsed(const MDS_Thread_t *thread);
+size_t MDS_ThreadGetThrottled(const MDS_Thread_t *thread);
+#endif
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+void MDS_ThreadGetStats(MDS_Thread_t *thread, MDS_ThreadStats_t *stats);
+#endif
+
+/* ThreadPool -------------------------------------------------------------- */
+typedef struct MDS_ThreadPool MDS_ThreadPool_t;
+
+typedef struct MDS_ThreadPoolWorker {
+    MDS_ThreadPool_t *pool;
+    MDS_Thread_t *thread;
+
+    // job dispatched
+    MDS_ThreadEntry_t entry;
+    MDS_Arg_t *arg;
+} MDS_ThreadPoolWorker_t;
+
+struct MDS_ThreadPool {
+    MDS_Object_t object;
+
+    MDS_ThreadPoolWorker_t *workers;
+    size_t nworkers;
+    MDS_WaitQueue_t queueIdle;  // parked workers
+    MDS_WaitQueue_t queueWait;  // dispatchers waiting for a parked worker
+
+    MDS_SpinLock_t spinlock;
+};
+
+MDS_Err_t MDS_ThreadPoolInit(MDS_ThreadPool_t *pool, const char *name, MDS_Thread_t threads[],
+                             MDS_ThreadPoolWorker_t workers[], size_t nthreads, void *stackPool,
+                             size_t stackSize, MDS_ThreadPriority_t priority,
+                             MDS_Timeout_t timeout);
+MDS_Err_t MDS_ThreadPoolDeInit(MDS_ThreadPool_t *pool);
+MDS_ThreadPool_t *MDS_ThreadPoolCreate(const char *name, size_t nthreads, size_t stackSize,
+                                       MDS_ThreadPriority_t priority, MDS_Timeout_t timeout);
+MDS_Err_t MDS_ThreadPoolDestroy(MDS_ThreadPool_t *pool);
+MDS_Err_t MDS_ThreadPoolDispatch(MDS_ThreadPool_t *pool, MDS_ThreadEntry_t entry,
+                                 MDS_Arg_t *arg, MDS_Timeout_t timeout);
+size_t MDS_ThreadPoolIdleCount(MDS_ThreadPool_t *pool);
 
 /* Semaphore --------------------------------------------------------------- */
 struct MDS_Semaphore {
     MDS_Object_t object;
     MDS_WaitQueue_t queueWait;
 
-    size_t value;
+    MDS_Atomic_t value;  // negative for the count of waiters
     size_t max;
+    size_t handoff;  // counts released to waiters dequeued but not yet run
 
     MDS_SpinLock_t spinlock;
 };
@@ -360,7 +635,14 @@ MDS_Err_t MDS_SemaphoreRelease(MDS_Semaphore_t *semaphore);
 size_t MDS_SemaphoreGetValue(const MDS_Semaphore_t *semaphore, size_t *max);
 
 /* Condition --------------------------------------------------------------- */
-typedef MDS_Semaphore_t MDS_Condition_t;
+typedef struct MDS_Condition {
+    MDS_Object_t object;
+    MDS_WaitQueue_t queueWait;
+
+    MDS_Mutex_t *mutex;  // mutex waiters are moved onto when woken
+
+    MDS_SpinLock_t spinlock;
+} MDS_Condition_t;
 
 MDS_Err_t MDS_ConditionInit(MDS_Condition_t *condition, const char *name);
 MDS_Err_t MDS_ConditionDeInit(MDS_Condition_t *condition);
@@ -374,9 +656,11 @@ MDS_Err_t MDS_ConditionWait(MDS_Condition_t *condition, MDS_Mutex_t *mutex, MDS_
 struct MDS_Mutex {
     MDS_Object_t object;
     MDS_WaitQueue_t queueWait;
+    MDS_DListNode_t nodeHold;
 
     MDS_Thread_t *owner;
-    MDS_ThreadPriority_t priority;
+    MDS_ThreadPriority_t priority;  // highest priority of waiters
+    MDS_ThreadPriority_t ceiling;   // priority raised to by owner while held
     int8_t value;
     int16_t nest;
 
@@ -384,28 +668,71 @@ struct MDS_Mutex {
 };
 
 MDS_Err_t MDS_MutexInit(MDS_Mutex_t *mutex, const char *name);
+MDS_Err_t MDS_MutexInitCeiling(MDS_Mutex_t *mutex, const char *name, MDS_ThreadPriority_t ceiling);
 MDS_Err_t MDS_MutexDeInit(MDS_Mutex_t *mutex);
 MDS_Mutex_t *MDS_MutexCreate(const char *name);
+MDS_Mutex_t *MDS_MutexCreateCeiling(const char *name, MDS_ThreadPriority_t ceiling);
 MDS_Err_t MDS_MutexDestroy(MDS_Mutex_t *mutex);
 MDS_Err_t MDS_MutexAcquire(MDS_Mutex_t *mutex, MDS_Timeout_t timeout);
 MDS_Err_t MDS_MutexRelease(MDS_Mutex_t *mutex);
 MDS_Thread_t *MDS_MutexGetOwner(const MDS_Mutex_t *mutex);
 
 /* RwLock ------------------------------------------------------------------ */
+typedef enum MDS_RwLockPrefer {
+    MDS_RWLOCK_PREFER_WRITER = 0,
+    MDS_RWLOCK_PREFER_READER,
+} MDS_RwLockPrefer_t;
+
 typedef struct MDS_RwLock {
-    MDS_Mutex_t mutex;
-    MDS_Condition_t condRd;
-    MDS_Condition_t condWr;
+    MDS_Object_t object;
+    MDS_WaitQueue_t queueRd;
+    MDS_WaitQueue_t queueWr;
+
+    MDS_Atomic_t state;  // writer flag | waiter flags | readers count
+    MDS_RwLockPrefer_t prefer;
 
-    int readers;
+    MDS_SpinLock_t spinlock;
 } MDS_RwLock_t;
 
 MDS_Err_t MDS_RwLockInit(MDS_RwLock_t *rwlock, const char *name);
+MDS_Err_t MDS_RwLockInitPrefer(MDS_RwLock_t *rwlock, const char *name, MDS_RwLockPrefer_t prefer);
 MDS_Err_t MDS_RwLockDeInit(MDS_RwLock_t *rwlock);
+MDS_RwLock_t *MDS_RwLockCreate(const char *name);
+MDS_RwLock_t *MDS_RwLockCreatePrefer(const char *name, MDS_RwLockPrefer_t prefer);
+MDS_Err_t MDS_RwLockDestroy(MDS_RwLock_t *rwlock);
 MDS_Err_t MDS_RwLockAcquireRead(MDS_RwLock_t *rwlock, MDS_Timeout_t timeout);
 MDS_Err_t MDS_RwLockAcquireWrite(MDS_RwLock_t *rwlock, MDS_Timeout_t timeout);
 MDS_Err_t MDS_RwLockRelease(MDS_RwLock_t *rwlock);
 
+/* SeqLock ----------------------------------------------------------------- */
+typedef struct MDS_SeqLock {
+    MDS_Atomic_t sequence;  // odd while a writer is in progress
+
+    MDS_SpinLock_t spinlock;
+} MDS_SeqLock_t;
+
+void MDS_SeqLockInit(MDS_SeqLock_t *seqlock);
+MDS_Lock_t MDS_SeqLockWriteBegin(MDS_SeqLock_t *seqlock);
+void MDS_SeqLockWriteEnd(MDS_SeqLock_t *seqlock, MDS_Lock_t lock);
+
+static inline uintptr_t MDS_SeqLockReadBegin(const MDS_SeqLock_t *seqlock)
+{
+    uintptr_t sequence;
+
+    do {
+        sequence = (uintptr_t)MDS_AtomicLoad(&(seqlock->sequence));
+    } while ((sequence & 1U) != 0U);
+
+    return (sequence);
+}
+
+static inline bool MDS_SeqLockReadRetry(const MDS_SeqLock_t *seqlock, uintptr_t sequence)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    return ((uintptr_t)MDS_AtomicLoad(&(seqlock->sequence)) != sequence);
+}
+
 /* Event ------------------------------------------------------------------- */
 struct MDS_Event {
     MDS_Object_t object;
@@ -423,6 +750,7 @@ MDS_Err_t MDS_EventDestroy(MDS_Event_t *event);
 MDS_Err_t MDS_EventWait(MDS_Event_t *event, MDS_Mask_t mask, MDS_EventOpt_t opt, MDS_Mask_t *recv,
                         MDS_Timeout_t timeout);
 MDS_Err_t MDS_EventSet(MDS_Event_t *event, MDS_Mask_t mask);
+MDS_Err_t MDS_EventBroadcast(MDS_Event_t *event, MDS_Mask_t mask);
 MDS_Err_t MDS_EventClr(MDS_Event_t *event, MDS_Mask_t mask);
 MDS_Mask_t MDS_EventGetValue(const MDS_Event_t *event);
 
@@ -530,10 +858,26 @@ void *MDS_SysMemCalloc(size_t nmemb, size_t size);
 void *MDS_SysMemRealloc(void *ptr, size_t size);
 void MDS_SysMemFree(void *ptr);
 
+/* LogAsync ---------------------------------------------------------------- */
+/*
+ * Log backend formatting into a bounded buffer drained by its own thread,
+ * the slow sink runs there instead of in the context that logged.
+ */
+MDS_Err_t MDS_LOG_AsyncStartup(MDS_LOG_VaPrint_t sink);
+size_t MDS_LOG_AsyncDropped(void);
+
 /* Hook -------------------------------------------------------------------- */
+#ifndef CONFIG_MDS_KERNEL_TRACE_ENABLE
+#define CONFIG_MDS_KERNEL_TRACE_ENABLE 0
+#endif
+
 #ifndef CONFIG_MDS_HOOK_ENABLE_KERNEL
+#if (CONFIG_MDS_KERNEL_TRACE_ENABLE != 0)
+#define CONFIG_MDS_HOOK_ENABLE_KERNEL 1
+#else
 #define CONFIG_MDS_HOOK_ENABLE_KERNEL 0
 #endif
+#endif
 
 typedef enum MDS_KERNEL_Trace {
     MDS_KERNEL_TRACE_SCHEDULER_SWITCH,
@@ -597,6 +941,39 @@ typedef struct MDS_HOOK_Kernel {
 
 MDS_HOOK_DECLARE(KERNEL, MDS_HOOK_Kernel_t);
 
+/* Trace ------------------------------------------------------------------- */
+/*
+ * Built-in consumer of the kernel hook, records fixed-size binary entries in a
+ * ring buffer per cpu. A dump is a header followed by `count` records, decode
+ * it on the host with tools/mds_trace.py.
+ */
+#define MDS_TRACE_MAGIC   0x5453444DU  // "MDST"
+#define MDS_TRACE_VERSION 1U
+
+typedef struct MDS_TraceRecord {
+    uint32_t timestamp;  // core cycles
+    uint8_t cpu;
+    uint8_t id;  // MDS_KERNEL_Trace_t
+    int16_t err;
+    uintptr_t object;
+    uintptr_t arg;  // other thread, size, block or timeout by id
+} MDS_TraceRecord_t;
+
+typedef struct MDS_TraceHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t recordSize;
+    uint8_t pointerSize;
+    uint32_t count;
+    uint32_t lost;  // records overwritten before dump
+} MDS_TraceHeader_t;
+
+#if (defined(CONFIG_MDS_KERNEL_TRACE_ENABLE) && (CONFIG_MDS_KERNEL_TRACE_ENABLE != 0))
+void MDS_TraceStart(void);
+void MDS_TraceStop(void);
+size_t MDS_TraceDump(void *buff, size_t size);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,10 @@ struct SCB_Typedef {
 
 #define SCB ((struct SCB_Typedef *)0xE000ED00)
 
+#define DEMCR      (*(volatile uint32_t *)0xE000EDFC)
+#define DWT_CTRL   (*(volatile uint32_t *)0xE0001000)
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004)
+
 /* Exception ---------------------------------------------------------------
  * MSP                                !< 0 Stack
  * Reset_Handler                      !< 1 Reset
@@ -233,6 +237,11 @@ bool MDS_CoreThreadStackCheck(MDS_Thread_t *thread)
     return (true);
 }
 
+uint32_t MDS_CoreCycleCount(void)
+{
+    return (DWT_CYCCNT);
+}
+
 /* CoreScheduler ----------------------------------------------------------- */
 #if (defined(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX) &&                                            \
      (CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX != 0))
@@ -259,6 +268,10 @@ void MDS_CoreSchedulerStartup(void *toSP)
     // SCB_SHPR3 Priority: PendSV = 0xFF, SysTick = 0x00
     SCB->SHPR3 = 0x00FF0000;
 
+    // DEMCR.TRCENA = 1, DWT_CTRL.CYCCNTENA = 1
+    DEMCR |= 0x01000000;
+    DWT_CTRL |= 0x00000001;
+
     // SCB_ICSR PendSV trig
     SCB->ICSR = 0x10000000;
 
@@ -398,6 +398,15 @@ bool MDS_CoreThreadStackCheck(MDS_Thread_t *thread)
     return (true);
 }
 
+uint32_t MDS_CoreCycleCount(void)
+{
+    uintptr_t cycle;
+
+    __asm volatile("csrr        %0, mcycle" : "=r"(cycle));
+
+    return ((uint32_t)cycle);
+}
+
 /* CoreScheduler ----------------------------------------------------------- */
 #if (defined(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX) &&                                            \
      (CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX != 0))
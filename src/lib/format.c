@@ -28,6 +28,7 @@ enum FMT_FormatFlag {
     FMT_FLAG_UPCASE = 0x0400U,
     FMT_FLAG_NEGATIVE = 0x0800U,
     FMT_FLAG_IGNORE = 0x1000U,
+    FMT_FLAG_TRIM = 0x2000U,
 };
 
 typedef struct FMT_Args {
@@ -59,12 +60,13 @@ static const char *FMT_ParsePrintFormatFlags(const char *fmt, va_list *ap, FMT_A
                               : (MDS_Strtol(fmt, (char **)(&fmt), MDS_NUM_DEC_BASE));
     args->width = (width < 0) ? (args->flags |= FMT_FLAG_LEFT, -width) : (width);
 
-    int prec = 0;
+    int prec = -1;
     if (*fmt == '.') {
         prec = ((*++fmt == '*') ? (fmt++, va_arg(*ap, int))
                                 : (MDS_Strtol(fmt, (char **)(&fmt), MDS_NUM_DEC_BASE)));
     }
-    args->precision = (prec > 0) ? (args->flags |= FMT_FLAG_PRECISION, (unsigned int)(prec)) : (0);
+    args->precision = (prec >= 0) ? (args->flags |= FMT_FLAG_PRECISION, (unsigned int)(prec))
+                                  : (0);
 
     if (*fmt == 'l') {
         args->flags |= (*++fmt == 'l') ? (fmt++, FMT_FLAG_LONG_LONG | FMT_FLAG_LONG)
@@ -72,7 +74,8 @@ static const char *FMT_ParsePrintFormatFlags(const char *fmt, va_list *ap, FMT_A
     } else if (*fmt == 'h') {
         args->flags |= (*++fmt == 'h') ? (fmt++, FMT_FLAG_SHORT | FMT_FLAG_CHAR)
                                        : (FMT_FLAG_SHORT);
-    } else if (*fmt == 'X') {
+    }
+    if (*fmt == 'X') {
         args->flags |= FMT_FLAG_UPCASE;
     }
 
@@ -159,21 +162,93 @@ static void FMT_PrintBuffInterger(char *buff, size_t size, size_t *pos, char *va
     *pos = FMT_PrintBuff(buff, size, *pos, valbuf, len, args);
 }
 
+static const char G_FMT_DIGITS_LUT[] = "00010203040506070809"
+                                     "10111213141516171819"
+                                     "20212223242526272829"
+                                     "30313233343536373839"
+                                     "40414243444546474849"
+                                     "50515253545556575859"
+                                     "60616263646566676869"
+                                     "70717273747576777879"
+                                     "80818283848586878889"
+                                     "90919293949596979899";
+
+static size_t FMT_UtoaDec32(char *valbuf, uint32_t value, size_t pad)
+{
+    size_t len = 0;
+
+    // two digits per step with constant divisor, valbuf is filled from the lowest digit
+    while (value >= 100U) {
+        uint32_t idx = (value % 100U) * 2U;
+        value /= 100U;
+        valbuf[len++] = G_FMT_DIGITS_LUT[idx + 1];
+        valbuf[len++] = G_FMT_DIGITS_LUT[idx];
+    }
+    if (value >= 10U) {
+        valbuf[len++] = G_FMT_DIGITS_LUT[value * 2U + 1];
+        valbuf[len++] = G_FMT_DIGITS_LUT[value * 2U];
+    } else {
+        valbuf[len++] = (char)(value + '0');
+    }
+    while (len < pad) {
+        valbuf[len++] = '0';
+    }
+
+    return (len);
+}
+
+static uint64_t FMT_Div1e8(uint64_t value)
+{
+    // value / 100000000 by multiply-high of reciprocal, no 64-bit division on 32-bit cores
+    const uint64_t magic = 0xABCC77118461CEFDULL;
+    uint64_t lo = (uint32_t)value, hi = value >> 32U;
+    uint64_t mlo = (uint32_t)magic, mhi = magic >> 32U;
+    uint64_t mid1 = hi * mlo + ((lo * mlo) >> 32U);
+    uint64_t mid2 = lo * mhi + (uint32_t)mid1;
+    uint64_t high = hi * mhi + (mid1 >> 32U) + (mid2 >> 32U);
+
+    return (high >> 26U);
+}
+
+static size_t FMT_UtoaDec(char *valbuf, unsigned long long value)
+{
+    size_t len = 0;
+
+    while (value > UINT32_MAX) {
+        uint64_t quot = FMT_Div1e8(value);
+        len += FMT_UtoaDec32(&(valbuf[len]), (uint32_t)(value - (quot * 100000000U)), 8U);
+        value = quot;
+    }
+
+    return (len + FMT_UtoaDec32(&(valbuf[len]), (uint32_t)(value), 0));
+}
+
+static size_t FMT_UtoaPow2(char *valbuf, unsigned long long value, unsigned int base, bool upcase)
+{
+    const char *digits = (upcase) ? ("0123456789ABCDEF") : ("0123456789abcdef");
+    unsigned int shift = (base == MDS_NUM_HEX_BASE)   ? (4U)
+                         : (base == MDS_NUM_OCT_BASE) ? (3U)
+                                                      : (1U);
+    size_t len = 0;
+
+    do {
+        valbuf[len++] = digits[value & (base - 1U)];
+    } while ((value >>= shift) > 0);
+
+    return (len);
+}
+
 static void FMT_lltoa(char *buff, size_t size, size_t *pos, unsigned long long value,
                       FMT_Args_t *args)
 {
     char valbuf[FMT_NTOA_BUFFER_SIZE];
-    size_t len = 0;
+    size_t len;
 
-    do {
-        unsigned char digit = (char)(value % args->base);
-        if (digit < MDS_NUM_DEC_BASE) {
-            valbuf[len++] = (char)(digit + '0');
-        } else {
-            valbuf[len++] = (char)(digit - MDS_NUM_DEC_BASE +
-                                   ((args->flags & FMT_FLAG_UPCASE) ? ('A') : ('a')));
-        }
-    } while (((value /= args->base) > 0) && (len < sizeof(valbuf)));
+    if (args->base == MDS_NUM_DEC_BASE) {
+        len = FMT_UtoaDec(valbuf, value);
+    } else {
+        len = FMT_UtoaPow2(valbuf, value, args->base, (args->flags & FMT_FLAG_UPCASE) != 0U);
+    }
 
     FMT_PrintBuffInterger(buff, size, pos, valbuf, len, args);
 }
@@ -234,6 +309,430 @@ static void FMT_PrintInteger(char *buff, size_t size, size_t *pos, const char ch
     FMT_lltoa(buff, size, pos, value, args);
 }
 
+#if (defined(CONFIG_MDS_FORMAT_WITH_FLOAT) && (CONFIG_MDS_FORMAT_WITH_FLOAT != 0))
+#define FMT_FTOA_BUFFER_SIZE       64
+#define FMT_FTOA_DIGITS_MAX        17
+#define FMT_FTOA_PRECISION_DEFAULT 6
+#define FMT_FTOA_PRECISION_MAX     (FMT_FTOA_BUFFER_SIZE - 8)
+#define FMT_FTOA_POW5_MAX          27
+
+typedef struct FMT_Uint128 {
+    uint64_t hi;
+    uint64_t lo;
+} FMT_Uint128_t;
+
+static const double G_FMT_POW10_TABLE[] = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+
+static double FMT_FtoaScale10(double value, int exp)
+{
+    unsigned int n = (exp < 0) ? ((unsigned int)(-exp)) : ((unsigned int)(exp));
+
+    // apply powers in place, never overflow while the result is representable
+    for (size_t idx = 0; (n != 0) && (idx < ARRAY_SIZE(G_FMT_POW10_TABLE)); idx++, n >>= 1U) {
+        if ((n & 1U) != 0U) {
+            value = (exp < 0) ? (value / G_FMT_POW10_TABLE[idx])
+                              : (value * G_FMT_POW10_TABLE[idx]);
+        }
+    }
+
+    return (value);
+}
+
+static int FMT_FtoaExp10(double value)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits = {.d = value};
+    int exp2 = (int)((bits.u >> 52U) & 0x7FFU);
+
+    if (exp2 == 0) {
+        bits.d = value * 18446744073709551616.0;  // subnormal, normalize by 2^64 exactly
+        exp2 = (int)((bits.u >> 52U) & 0x7FFU) - 64;
+    }
+
+    // floor((exp2 - 1023) * log10(2)), which is the decimal exponent or one below it
+    return (((exp2 - 1023) * 78913) >> 18);
+}
+
+static FMT_Uint128_t FMT_FtoaMulAdd(uint64_t a, uint64_t b, uint64_t c)
+{
+    uint64_t ll = (a & 0xFFFFFFFFU) * (b & 0xFFFFFFFFU);
+    uint64_t lh = (a & 0xFFFFFFFFU) * (b >> 32U);
+    uint64_t hl = (a >> 32U) * (b & 0xFFFFFFFFU);
+    uint64_t hh = (a >> 32U) * (b >> 32U);
+    uint64_t mid = (ll >> 32U) + (lh & 0xFFFFFFFFU) + (hl & 0xFFFFFFFFU);
+    FMT_Uint128_t ret = {
+        .hi = hh + (lh >> 32U) + (hl >> 32U) + (mid >> 32U),
+        .lo = (mid << 32U) | (ll & 0xFFFFFFFFU),
+    };
+
+    ret.lo += c;
+    if (ret.lo < c) {
+        ret.hi += 1;
+    }
+
+    return (ret);
+}
+
+static bool FMT_FtoaShiftRight(FMT_Uint128_t *val, unsigned int shift)
+{
+    bool sticky = false;
+
+    // report whether any set bit is shifted out
+    if (shift >= 128U) {
+        sticky = (val->hi | val->lo) != 0U;
+        val->hi = 0;
+        val->lo = 0;
+    } else if (shift >= 64U) {
+        sticky = (val->lo != 0U) || ((shift > 64U) && ((val->hi << (128U - shift)) != 0U));
+        val->lo = val->hi >> (shift - 64U);
+        val->hi = 0;
+    } else if (shift > 0U) {
+        sticky = (val->lo << (64U - shift)) != 0U;
+        val->lo = (val->lo >> shift) | (val->hi << (64U - shift));
+        val->hi >>= shift;
+    }
+
+    return (sticky);
+}
+
+static int FMT_FtoaCompare(double value, int exp, uint64_t mant, unsigned int halves)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits = {.d = value};
+    uint64_t frac = bits.u & 0x000FFFFFFFFFFFFFU;
+    int exp2 = (int)((bits.u >> 52U) & 0x7FFU);
+    unsigned int n = (exp < 0) ? ((unsigned int)(-exp)) : ((unsigned int)(exp));
+    uint64_t pow5 = 1;
+
+    for (unsigned int idx = 0; idx < n; idx++) {
+        pow5 *= 5U;
+    }
+    if (exp2 != 0) {
+        frac |= 0x0010000000000000U;
+    } else {
+        exp2 = 1;
+    }
+
+    // sign of 2 * value * 10^exp - (2 * mant + halves), as lhs * 2^exp2 against rhs
+    FMT_Uint128_t lhs, rhs;
+    if (exp < 0) {
+        lhs = FMT_FtoaMulAdd(frac, 1U, 0U);
+        rhs = FMT_FtoaMulAdd(mant, pow5 * 2U, pow5 * halves);
+    } else {
+        lhs = FMT_FtoaMulAdd(frac, pow5, 0U);
+        rhs = FMT_FtoaMulAdd(mant, 2U, halves);
+    }
+    exp2 = exp2 - 1074 + exp;
+
+    bool sticky = (exp2 < 0) ? FMT_FtoaShiftRight(&lhs, (unsigned int)(-exp2))
+                             : FMT_FtoaShiftRight(&rhs, (unsigned int)(exp2));
+    if (lhs.hi != rhs.hi) {
+        return ((lhs.hi > rhs.hi) ? (1) : (-1));
+    } else if (lhs.lo != rhs.lo) {
+        return ((lhs.lo > rhs.lo) ? (1) : (-1));
+    } else if (sticky) {
+        return ((exp2 < 0) ? (1) : (-1));
+    }
+
+    return (0);
+}
+
+static uint64_t FMT_FtoaScaleRound(double value, int exp)
+{
+    double scaled = FMT_FtoaScale10(value, exp);
+    uint64_t mant = (uint64_t)scaled;
+    int half;
+
+    if ((exp < -FMT_FTOA_POW5_MAX) || (exp > FMT_FTOA_POW5_MAX)) {
+        // 5^exp is past 64 bits, a scaled half is taken as above it
+        half = ((scaled - (double)mant) >= 0.5) ? (1) : (-1);
+    } else {
+        // the scaled guess is a few units off at most, settle it on the exact mantissa
+        while ((mant > 0U) && (FMT_FtoaCompare(value, exp, mant, 0U) < 0)) {
+            mant -= 1;
+        }
+        while (FMT_FtoaCompare(value, exp, mant, 2U) >= 0) {
+            mant += 1;
+        }
+        half = FMT_FtoaCompare(value, exp, mant, 1U);
+    }
+
+    // half-even only on a true tie
+    if ((half > 0) || ((half == 0) && ((mant & 1U) != 0U))) {
+        mant += 1;
+    }
+
+    return (mant);
+}
+
+static size_t FMT_FtoaMantissa(char *digits, uint64_t mant)
+{
+    char valbuf[FMT_NTOA_BUFFER_SIZE];
+    size_t len = FMT_UtoaDec(valbuf, mant);
+
+    for (size_t idx = 0; idx < len; idx++) {
+        digits[idx] = valbuf[len - idx - 1];
+    }
+
+    return (len);
+}
+
+static size_t FMT_FtoaDigits(char *digits, double value, size_t ndigits, int *exp10)
+{
+    uint64_t lower = 1, upper;
+    uint64_t mant = 0;
+    int exp = 0;
+
+    if (value != 0.0) {
+        for (size_t idx = 1; idx < ndigits; idx++) {
+            lower *= MDS_NUM_DEC_BASE;
+        }
+        upper = lower * MDS_NUM_DEC_BASE;
+
+        exp = FMT_FtoaExp10(value);
+        double scaled = FMT_FtoaScale10(value, (int)(ndigits)-1 - exp);
+        if (scaled >= (double)upper) {
+            exp += 1;
+        }
+
+        mant = FMT_FtoaScaleRound(value, (int)(ndigits)-1 - exp);
+        if (mant < lower) {
+            mant = lower;
+        } else if (mant >= upper) {
+            mant /= MDS_NUM_DEC_BASE;
+            exp += 1;
+        }
+    }
+
+    *exp10 = exp;
+
+    return (FMT_FtoaMantissa(digits, mant));
+}
+
+static size_t FMT_FtoaNumDigits(size_t ndigits)
+{
+    return ((ndigits < FMT_FTOA_DIGITS_MAX) ? (ndigits) : (FMT_FTOA_DIGITS_MAX));
+}
+
+static size_t FMT_FtoaTrimZero(char *out, size_t len, size_t point)
+{
+    if (point < len) {
+        while ((len > (point + 1)) && (out[len - 1] == '0')) {
+            len--;
+        }
+        if (len == (point + 1)) {
+            len--;
+        }
+    }
+
+    return (len);
+}
+
+static size_t FMT_FtoaFixed(char *out, const char *digits, size_t ndigits, int last,
+                            size_t prec, unsigned int flags)
+{
+    // value is digits * 10^last
+    int ipart = (int)(ndigits) + last;
+    size_t len = 0;
+
+    if (ipart <= 0) {
+        out[len++] = '0';
+    }
+    for (int idx = 0; idx < ipart; idx++) {
+        out[len++] = (idx < (int)(ndigits)) ? (digits[idx]) : ('0');
+    }
+
+    size_t point = len;
+    if ((prec > 0) || ((flags & FMT_FLAG_HASH) != 0U)) {
+        out[len++] = '.';
+    }
+    for (size_t idx = 0; idx < prec; idx++) {
+        int pos = ipart + (int)(idx);
+        out[len++] = ((pos >= 0) && (pos < (int)(ndigits))) ? (digits[pos]) : ('0');
+    }
+
+    if ((flags & FMT_FLAG_TRIM) != 0U) {
+        len = FMT_FtoaTrimZero(out, len, point);
+    }
+
+    return (len);
+}
+
+static size_t FMT_FtoaExponent(char *out, const char *digits, size_t ndigits, int exp10,
+                               size_t prec, unsigned int flags)
+{
+    size_t len = 0;
+
+    out[len++] = digits[0];
+    if ((prec > 0) || ((flags & FMT_FLAG_HASH) != 0U)) {
+        out[len++] = '.';
+    }
+    for (size_t idx = 1; idx <= prec; idx++) {
+        out[len++] = (idx < ndigits) ? (digits[idx]) : ('0');
+    }
+
+    if ((flags & FMT_FLAG_TRIM) != 0U) {
+        len = FMT_FtoaTrimZero(out, len, 1);
+    }
+
+    out[len++] = ((flags & FMT_FLAG_UPCASE) != 0U) ? ('E') : ('e');
+    out[len++] = (exp10 < 0) ? ('-') : ('+');
+    exp10 = (exp10 < 0) ? (-exp10) : (exp10);
+    if (exp10 >= 100) {
+        out[len++] = (char)((exp10 / 100) + '0');
+        exp10 %= 100;
+    }
+    out[len++] = G_FMT_DIGITS_LUT[exp10 * 2];
+    out[len++] = G_FMT_DIGITS_LUT[exp10 * 2 + 1];
+
+    return (len);
+}
+
+static size_t FMT_FtoaPrintFixed(char *out, double value, size_t prec, unsigned int flags)
+{
+    char digits[FMT_NTOA_BUFFER_SIZE];
+    size_t ndigits;
+    int last, exp10;
+
+    // integer and fraction converted apart keep the fraction digits out of the double rounding
+    if (value < 9223372036854775808.0) {
+        size_t fprec = FMT_FtoaNumDigits(prec);
+        uint64_t ipart = (uint64_t)value;
+        uint64_t fpart = 0;
+
+        if (fprec == 0) {
+            ipart = FMT_FtoaScaleRound(value, 0);
+        } else {
+            uint64_t limit = 1;
+            for (size_t idx = 0; idx < fprec; idx++) {
+                limit *= MDS_NUM_DEC_BASE;
+            }
+            fpart = FMT_FtoaScaleRound(value - (double)ipart, (int)(fprec));
+            if (fpart >= limit) {
+                fpart -= limit;
+                ipart += 1;
+            }
+        }
+
+        ndigits = FMT_FtoaMantissa(digits, ipart);
+        if (fprec > 0) {
+            char fdigits[FMT_NTOA_BUFFER_SIZE];
+            size_t flen = FMT_FtoaMantissa(fdigits, fpart);
+            for (size_t idx = flen; idx < fprec; idx++) {
+                digits[ndigits++] = '0';
+            }
+            for (size_t idx = 0; idx < flen; idx++) {
+                digits[ndigits++] = fdigits[idx];
+            }
+        }
+        last = -(int)(fprec);
+    } else {
+        ndigits = FMT_FtoaDigits(digits, value, FMT_FTOA_DIGITS_MAX, &exp10);
+        last = exp10 - (FMT_FTOA_DIGITS_MAX - 1);
+    }
+
+    if (((int)(ndigits) + last + 1 + (int)(prec)) >= (FMT_FTOA_BUFFER_SIZE - 1)) {
+        ndigits = FMT_FtoaDigits(digits, value, FMT_FtoaNumDigits(prec + 1), &exp10);
+        return (FMT_FtoaExponent(out, digits, ndigits, exp10, prec, flags));
+    }
+
+    return (FMT_FtoaFixed(out, digits, ndigits, last, prec, flags));
+}
+
+static size_t FMT_FtoaPrintGeneral(char *out, double value, size_t prec, unsigned int flags)
+{
+    char digits[FMT_NTOA_BUFFER_SIZE];
+    int exp10;
+
+    if (prec == 0) {
+        prec = 1;
+    }
+    if ((flags & FMT_FLAG_HASH) == 0U) {
+        flags |= FMT_FLAG_TRIM;
+    }
+
+    size_t ndigits = FMT_FtoaDigits(digits, value, FMT_FtoaNumDigits(prec), &exp10);
+    if ((exp10 >= -4) && (exp10 < (int)(prec))) {
+        return (FMT_FtoaFixed(out, digits, ndigits, exp10 + 1 - (int)(ndigits),
+                              prec - 1 - exp10, flags));
+    }
+
+    return (FMT_FtoaExponent(out, digits, ndigits, exp10, prec - 1, flags));
+}
+
+static void FMT_PrintFloat(char *buff, size_t size, size_t *pos, const char ch, va_list *ap,
+                           FMT_Args_t *args)
+{
+    char out[FMT_FTOA_BUFFER_SIZE];
+    size_t len = 0;
+    double value = va_arg(*ap, double);
+    union {
+        double d;
+        uint64_t u;
+    } bits = {.d = value};
+
+    if ((bits.u >> 63U) != 0U) {
+        args->flags |= FMT_FLAG_NEGATIVE;
+        value = -value;
+    }
+    if ((ch == 'F') || (ch == 'E') || (ch == 'G')) {
+        args->flags |= FMT_FLAG_UPCASE;
+    }
+
+    if ((args->flags & FMT_FLAG_NEGATIVE) != 0U) {
+        out[len++] = '-';
+    } else if ((args->flags & FMT_FLAG_PLUS) != 0U) {
+        out[len++] = '+';
+    } else if ((args->flags & FMT_FLAG_SPACE) != 0U) {
+        out[len++] = ' ';
+    }
+    size_t sign = len;
+
+    size_t prec = ((args->flags & FMT_FLAG_PRECISION) != 0U) ? (args->precision)
+                                                               : (FMT_FTOA_PRECISION_DEFAULT);
+    prec = (prec < FMT_FTOA_PRECISION_MAX) ? (prec) : (FMT_FTOA_PRECISION_MAX);
+    unsigned int flags = args->flags & (FMT_FLAG_HASH | FMT_FLAG_UPCASE);
+
+    if (((bits.u >> 52U) & 0x7FFU) == 0x7FFU) {
+        const char *str = ((bits.u & 0xFFFFFFFFFFFFFULL) != 0U)
+                              ? (((flags & FMT_FLAG_UPCASE) != 0U) ? ("NAN") : ("nan"))
+                              : (((flags & FMT_FLAG_UPCASE) != 0U) ? ("INF") : ("inf"));
+        while (*str != '\0') {
+            out[len++] = *str++;
+        }
+        args->flags &= ~FMT_FLAG_ZERO;
+    } else if ((ch == 'f') || (ch == 'F')) {
+        len += FMT_FtoaPrintFixed(&(out[len]), value, prec, flags);
+    } else if ((ch == 'e') || (ch == 'E')) {
+        char digits[FMT_NTOA_BUFFER_SIZE];
+        int exp10;
+        size_t ndigits = FMT_FtoaDigits(digits, value, FMT_FtoaNumDigits(prec + 1),
+                                        &exp10);
+        len += FMT_FtoaExponent(&(out[len]), digits, ndigits, exp10, prec, flags);
+    } else {
+        len += FMT_FtoaPrintGeneral(&(out[len]), value, prec, flags);
+    }
+
+    // zeros go between the sign and the digits
+    args->base = 0;
+    if (((args->flags & FMT_FLAG_ZERO) != 0U) && ((args->flags & FMT_FLAG_LEFT) == 0U)) {
+        for (size_t idx = 0; (idx < sign) && (*pos < size); idx++) {
+            buff[(*pos)++] = out[idx];
+        }
+        for (size_t idx = len; (idx < args->width) && (*pos < size); idx++) {
+            buff[(*pos)++] = '0';
+        }
+        *pos = FMT_PrintBuff(buff, size, *pos, &(out[sign]), len - sign, args);
+    } else {
+        *pos = FMT_PrintBuff(buff, size, *pos, out, len, args);
+    }
+}
+#endif
+
 static void FMT_PrintChar(char *buff, size_t size, size_t *pos, va_list *ap, FMT_Args_t *args)
 {
     char ch = (char)va_arg(*ap, int);
@@ -23,6 +23,35 @@ bool MDS_MemAddrIsAligned(const void *addr, uintptr_t align)
     return (false);
 }
 
+#if (!(defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0)))
+#define MDS_MEMBUFF_WORD_BITS (sizeof(size_t) * MDS_BITS_OF_BYTE)
+
+static inline size_t MDS_MemBuffWordMerge(size_t prev, size_t next, size_t shift)
+{
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
+    return ((prev << shift) | (next >> (MDS_MEMBUFF_WORD_BITS - shift)));
+#else
+    return ((prev >> shift) | (next << (MDS_MEMBUFF_WORD_BITS - shift)));
+#endif
+}
+
+static size_t MDS_MemBuffCopyShift(size_t *d, const uint8_t *s, size_t words)
+{
+    size_t shift = ((uintptr_t)s & (sizeof(size_t) - 1)) * MDS_BITS_OF_BYTE;
+    const size_t *ws = (const size_t *)((uintptr_t)s & ~(uintptr_t)(sizeof(size_t) - 1));
+    size_t prev = *ws++;
+
+    // every aligned word loaded holds at least one source byte, no over-read past a page
+    for (size_t cnt = 0; cnt < words; cnt++) {
+        size_t next = *ws++;
+        d[cnt] = MDS_MemBuffWordMerge(prev, next, shift);
+        prev = next;
+    }
+
+    return (words * sizeof(size_t));
+}
+#endif
+
 void *MDS_MemBuffSet(void *dst, int c, size_t size)
 {
     uint8_t *ptr = dst;
@@ -33,18 +62,27 @@ void *MDS_MemBuffSet(void *dst, int c, size_t size)
         *ptr++ = c;
     }
 #else
+    size_t word = (((size_t)(-1)) / 0xFFU) * (uint8_t)c;
+
+    while ((ptr < end) && (!MDS_MemAddrIsAligned(ptr, sizeof(size_t)))) {
+        *ptr++ = c;
+    }
+
+    while (((uintptr_t)end - (uintptr_t)ptr) >= (sizeof(size_t) * 4)) {
+        ((size_t *)ptr)[0] = word;
+        ((size_t *)ptr)[1] = word;
+        ((size_t *)ptr)[2] = word;
+        ((size_t *)ptr)[3] = word;
+        ptr += sizeof(size_t) * 4;
+    }
+
+    while (((uintptr_t)end - (uintptr_t)ptr) >= sizeof(size_t)) {
+        *((size_t *)ptr) = word;
+        ptr += sizeof(size_t);
+    }
+
     while (ptr < end) {
-        if ((((uintptr_t)end - (uintptr_t)ptr) >= sizeof(size_t)) &&
-            (((uintptr_t)ptr - (uintptr_t)dst) >= sizeof(size_t)) &&
-            MDS_MemAddrIsAligned(ptr, sizeof(size_t))) {
-            uint8_t *align = ptr - sizeof(size_t);
-            while (((uintptr_t)end - (uintptr_t)ptr) >= sizeof(size_t)) {
-                *((size_t *)ptr) = *((size_t *)align);
-                ptr += sizeof(size_t);
-            }
-        } else {
-            *ptr++ = c;
-        }
+        *ptr++ = c;
     }
 #endif
 
@@ -62,17 +100,33 @@ size_t MDS_MemBuffCopy(void *dst, size_t size, const void *src, size_t len)
         *d++ = *s++;
     }
 #else
-    while (s < e) {
-        if (MDS_MemAddrIsAligned(d, sizeof(size_t)) && MDS_MemAddrIsAligned(s, sizeof(size_t)) &&
-            (((uintptr_t)(e - s)) >= sizeof(size_t))) {
-            while (((uintptr_t)(e - s)) >= sizeof(size_t)) {
-                *((size_t *)d) = *((size_t *)s);
-                d += sizeof(size_t);
-                s += sizeof(size_t);
-            }
-        } else {
-            *d++ = *s++;
+    while ((s < e) && (!MDS_MemAddrIsAligned(d, sizeof(size_t)))) {
+        *d++ = *s++;
+    }
+
+    if (MDS_MemAddrIsAligned(s, sizeof(size_t))) {
+        while (((uintptr_t)(e - s)) >= (sizeof(size_t) * 4)) {
+            ((size_t *)d)[0] = ((const size_t *)s)[0];
+            ((size_t *)d)[1] = ((const size_t *)s)[1];
+            ((size_t *)d)[2] = ((const size_t *)s)[2];
+            ((size_t *)d)[3] = ((const size_t *)s)[3];
+            d += sizeof(size_t) * 4;
+            s += sizeof(size_t) * 4;
         }
+        while (((uintptr_t)(e - s)) >= sizeof(size_t)) {
+            *((size_t *)d) = *((const size_t *)s);
+            d += sizeof(size_t);
+            s += sizeof(size_t);
+        }
+    } else if (((uintptr_t)(e - s)) >= sizeof(size_t)) {
+        // mutually misaligned, merge two aligned source words into each destination word
+        size_t ofs = MDS_MemBuffCopyShift((size_t *)d, s, (uintptr_t)(e - s) / sizeof(size_t));
+        d += ofs;
+        s += ofs;
+    }
+
+    while (s < e) {
+        *d++ = *s++;
     }
 #endif
 
@@ -107,6 +161,24 @@ int MDS_MemBuffCmp(const void *buf1, const void *buf2, size_t size)
     const uint8_t *p1 = buf1;
     const uint8_t *p2 = buf2;
 
+#if (!(defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0)))
+    if ((((uintptr_t)p1 ^ (uintptr_t)p2) & (sizeof(size_t) - 1)) == 0) {
+        while ((size > 0) && (!MDS_MemAddrIsAligned(p1, sizeof(size_t)))) {
+            if ((cmp = *p1++ - *p2++) != 0) {
+                return (cmp);
+            }
+            size -= sizeof(uint8_t);
+        }
+
+        // skip equal words, the first differing one is resolved by the byte loop
+        while ((size >= sizeof(size_t)) && (*((const size_t *)p1) == *((const size_t *)p2))) {
+            p1 += sizeof(size_t);
+            p2 += sizeof(size_t);
+            size -= sizeof(size_t);
+        }
+    }
+#endif
+
     while ((size > 0) && (cmp == 0)) {
         cmp = *p1++ - *p2++;
         size -= sizeof(uint8_t);
@@ -13,6 +13,102 @@
 #include "mds_def.h"
 #include "mds_log.h"
 
+/* Variable ---------------------------------------------------------------- */
+#if (defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0))
+static const uint32_t G_MSGLIST_CRC32_TABLE[] = {
+    0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+    0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+    0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+    0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+};
+
+static const uint16_t G_MSGLIST_CRC16_TABLE[] = {
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+};
+#else
+static const uint32_t G_MSGLIST_CRC32_TABLE[] = {
+    0x00000000U, 0x77073096U, 0xEE0E612CU, 0x990951BAU, 0x076DC419U, 0x706AF48FU,
+    0xE963A535U, 0x9E6495A3U, 0x0EDB8832U, 0x79DCB8A4U, 0xE0D5E91EU, 0x97D2D988U,
+    0x09B64C2BU, 0x7EB17CBDU, 0xE7B82D07U, 0x90BF1D91U, 0x1DB71064U, 0x6AB020F2U,
+    0xF3B97148U, 0x84BE41DEU, 0x1ADAD47DU, 0x6DDDE4EBU, 0xF4D4B551U, 0x83D385C7U,
+    0x136C9856U, 0x646BA8C0U, 0xFD62F97AU, 0x8A65C9ECU, 0x14015C4FU, 0x63066CD9U,
+    0xFA0F3D63U, 0x8D080DF5U, 0x3B6E20C8U, 0x4C69105EU, 0xD56041E4U, 0xA2677172U,
+    0x3C03E4D1U, 0x4B04D447U, 0xD20D85FDU, 0xA50AB56BU, 0x35B5A8FAU, 0x42B2986CU,
+    0xDBBBC9D6U, 0xACBCF940U, 0x32D86CE3U, 0x45DF5C75U, 0xDCD60DCFU, 0xABD13D59U,
+    0x26D930ACU, 0x51DE003AU, 0xC8D75180U, 0xBFD06116U, 0x21B4F4B5U, 0x56B3C423U,
+    0xCFBA9599U, 0xB8BDA50FU, 0x2802B89EU, 0x5F058808U, 0xC60CD9B2U, 0xB10BE924U,
+    0x2F6F7C87U, 0x58684C11U, 0xC1611DABU, 0xB6662D3DU, 0x76DC4190U, 0x01DB7106U,
+    0x98D220BCU, 0xEFD5102AU, 0x71B18589U, 0x06B6B51FU, 0x9FBFE4A5U, 0xE8B8D433U,
+    0x7807C9A2U, 0x0F00F934U, 0x9609A88EU, 0xE10E9818U, 0x7F6A0DBBU, 0x086D3D2DU,
+    0x91646C97U, 0xE6635C01U, 0x6B6B51F4U, 0x1C6C6162U, 0x856530D8U, 0xF262004EU,
+    0x6C0695EDU, 0x1B01A57BU, 0x8208F4C1U, 0xF50FC457U, 0x65B0D9C6U, 0x12B7E950U,
+    0x8BBEB8EAU, 0xFCB9887CU, 0x62DD1DDFU, 0x15DA2D49U, 0x8CD37CF3U, 0xFBD44C65U,
+    0x4DB26158U, 0x3AB551CEU, 0xA3BC0074U, 0xD4BB30E2U, 0x4ADFA541U, 0x3DD895D7U,
+    0xA4D1C46DU, 0xD3D6F4FBU, 0x4369E96AU, 0x346ED9FCU, 0xAD678846U, 0xDA60B8D0U,
+    0x44042D73U, 0x33031DE5U, 0xAA0A4C5FU, 0xDD0D7CC9U, 0x5005713CU, 0x270241AAU,
+    0xBE0B1010U, 0xC90C2086U, 0x5768B525U, 0x206F85B3U, 0xB966D409U, 0xCE61E49FU,
+    0x5EDEF90EU, 0x29D9C998U, 0xB0D09822U, 0xC7D7A8B4U, 0x59B33D17U, 0x2EB40D81U,
+    0xB7BD5C3BU, 0xC0BA6CADU, 0xEDB88320U, 0x9ABFB3B6U, 0x03B6E20CU, 0x74B1D29AU,
+    0xEAD54739U, 0x9DD277AFU, 0x04DB2615U, 0x73DC1683U, 0xE3630B12U, 0x94643B84U,
+    0x0D6D6A3EU, 0x7A6A5AA8U, 0xE40ECF0BU, 0x9309FF9DU, 0x0A00AE27U, 0x7D079EB1U,
+    0xF00F9344U, 0x8708A3D2U, 0x1E01F268U, 0x6906C2FEU, 0xF762575DU, 0x806567CBU,
+    0x196C3671U, 0x6E6B06E7U, 0xFED41B76U, 0x89D32BE0U, 0x10DA7A5AU, 0x67DD4ACCU,
+    0xF9B9DF6FU, 0x8EBEEFF9U, 0x17B7BE43U, 0x60B08ED5U, 0xD6D6A3E8U, 0xA1D1937EU,
+    0x38D8C2C4U, 0x4FDFF252U, 0xD1BB67F1U, 0xA6BC5767U, 0x3FB506DDU, 0x48B2364BU,
+    0xD80D2BDAU, 0xAF0A1B4CU, 0x36034AF6U, 0x41047A60U, 0xDF60EFC3U, 0xA867DF55U,
+    0x316E8EEFU, 0x4669BE79U, 0xCB61B38CU, 0xBC66831AU, 0x256FD2A0U, 0x5268E236U,
+    0xCC0C7795U, 0xBB0B4703U, 0x220216B9U, 0x5505262FU, 0xC5BA3BBEU, 0xB2BD0B28U,
+    0x2BB45A92U, 0x5CB36A04U, 0xC2D7FFA7U, 0xB5D0CF31U, 0x2CD99E8BU, 0x5BDEAE1DU,
+    0x9B64C2B0U, 0xEC63F226U, 0x756AA39CU, 0x026D930AU, 0x9C0906A9U, 0xEB0E363FU,
+    0x72076785U, 0x05005713U, 0x95BF4A82U, 0xE2B87A14U, 0x7BB12BAEU, 0x0CB61B38U,
+    0x92D28E9BU, 0xE5D5BE0DU, 0x7CDCEFB7U, 0x0BDBDF21U, 0x86D3D2D4U, 0xF1D4E242U,
+    0x68DDB3F8U, 0x1FDA836EU, 0x81BE16CDU, 0xF6B9265BU, 0x6FB077E1U, 0x18B74777U,
+    0x88085AE6U, 0xFF0F6A70U, 0x66063BCAU, 0x11010B5CU, 0x8F659EFFU, 0xF862AE69U,
+    0x616BFFD3U, 0x166CCF45U, 0xA00AE278U, 0xD70DD2EEU, 0x4E048354U, 0x3903B3C2U,
+    0xA7672661U, 0xD06016F7U, 0x4969474DU, 0x3E6E77DBU, 0xAED16A4AU, 0xD9D65ADCU,
+    0x40DF0B66U, 0x37D83BF0U, 0xA9BCAE53U, 0xDEBB9EC5U, 0x47B2CF7FU, 0x30B5FFE9U,
+    0xBDBDF21CU, 0xCABAC28AU, 0x53B39330U, 0x24B4A3A6U, 0xBAD03605U, 0xCDD70693U,
+    0x54DE5729U, 0x23D967BFU, 0xB3667A2EU, 0xC4614AB8U, 0x5D681B02U, 0x2A6F2B94U,
+    0xB40BBE37U, 0xC30C8EA1U, 0x5A05DF1BU, 0x2D02EF8DU,
+};
+
+static const uint16_t G_MSGLIST_CRC16_TABLE[] = {
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+    0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+    0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+    0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+    0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+    0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+    0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+    0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+    0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+    0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+    0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+    0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+    0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+    0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+    0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+    0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+    0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+    0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+    0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+    0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+    0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+    0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+    0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+    0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+    0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+    0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+    0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+    0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+    0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+    0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+    0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U,
+};
+#endif
+
 /* Message ----------------------------------------------------------------- */
 size_t MDS_MsgListGetLength(const MDS_MsgList_t *msg)
 {
@@ -44,3 +140,238 @@ size_t MDS_MsgListCopyBuff(void *buff, size_t size, const MDS_MsgList_t *msg)
 
     return (len);
 }
+
+static const MDS_MsgList_t *MSGLIST_Seek(const MDS_MsgList_t *msg, size_t *offset)
+{
+    const MDS_MsgList_t *cur = msg;
+
+    while ((cur != NULL) && (*offset >= cur->len)) {
+        *offset -= cur->len;
+        cur = cur->next;
+    }
+
+    return (cur);
+}
+
+size_t MDS_MsgListReadBuff(void *buff, size_t size, const MDS_MsgList_t *msg, size_t offset)
+{
+    MDS_ASSERT(buff != NULL);
+
+    size_t len = 0;
+
+    for (const MDS_MsgList_t *cur = MSGLIST_Seek(msg, &offset); (cur != NULL) && (len < size);
+         cur = cur->next) {
+        len += MDS_MemBuffCopy((uint8_t *)buff + len, size - len,
+                               (const uint8_t *)(cur->buff) + offset, cur->len - offset);
+        offset = 0;
+    }
+
+    return (len);
+}
+
+int MDS_MsgListCmpBuff(const MDS_MsgList_t *msg, size_t offset, const void *buff, size_t len)
+{
+    MDS_ASSERT(buff != NULL);
+
+    const uint8_t *ptr = buff;
+
+    for (const MDS_MsgList_t *cur = MSGLIST_Seek(msg, &offset); len > 0; cur = cur->next) {
+        if (cur == NULL) {
+            return (-1);
+        }
+
+        size_t cnt = ((cur->len - offset) < len) ? (cur->len - offset) : (len);
+        int cmp = MDS_MemBuffCmp((const uint8_t *)(cur->buff) + offset, ptr, cnt);
+        if (cmp != 0) {
+            return (cmp);
+        }
+        ptr += cnt;
+        len -= cnt;
+        offset = 0;
+    }
+
+    return (0);
+}
+
+size_t MDS_MsgListCopyList(const MDS_MsgList_t *dst, const MDS_MsgList_t *src)
+{
+    size_t len = 0;
+    size_t dofs = 0, sofs = 0;
+
+    while ((dst != NULL) && (src != NULL)) {
+        size_t cnt = MDS_MemBuffCopy((uint8_t *)(uintptr_t)(dst->buff) + dofs, dst->len - dofs,
+                                     (const uint8_t *)(src->buff) + sofs, src->len - sofs);
+        len += cnt;
+        dofs += cnt;
+        sofs += cnt;
+        if (dofs >= dst->len) {
+            dst = dst->next;
+            dofs = 0;
+        }
+        if (sofs >= src->len) {
+            src = src->next;
+            sofs = 0;
+        }
+    }
+
+    return (len);
+}
+
+size_t MDS_MsgListSlice(MDS_MsgList_t *slice, size_t count, const MDS_MsgList_t *msg,
+                        size_t offset, size_t len)
+{
+    MDS_ASSERT((slice != NULL) || (count == 0));
+
+    size_t total = 0;
+    size_t idx = 0;
+
+    for (const MDS_MsgList_t *cur = MSGLIST_Seek(msg, &offset);
+         (cur != NULL) && (idx < count) && (total < len); cur = cur->next) {
+        size_t cnt = ((cur->len - offset) < (len - total)) ? (cur->len - offset) : (len - total);
+        if (cnt == 0) {
+            continue;
+        }
+        slice[idx].buff = (const uint8_t *)(cur->buff) + offset;
+        slice[idx].len = cnt;
+        slice[idx].next = NULL;
+        if (idx > 0) {
+            slice[idx - 1].next = &(slice[idx]);
+        }
+        total += cnt;
+        offset = 0;
+        idx += 1;
+    }
+
+    return (total);
+}
+
+static uint32_t MSGLIST_Crc32(uint32_t crc, const uint8_t *ptr, size_t len)
+{
+    while (len-- > 0) {
+#if (defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0))
+        crc ^= *ptr++;
+        crc = (crc >> 4U) ^ G_MSGLIST_CRC32_TABLE[crc & 0x0FU];
+        crc = (crc >> 4U) ^ G_MSGLIST_CRC32_TABLE[crc & 0x0FU];
+#else
+        crc = (crc >> MDS_BITS_OF_BYTE) ^ G_MSGLIST_CRC32_TABLE[(crc ^ *ptr++) & 0xFFU];
+#endif
+    }
+
+    return (crc);
+}
+
+uint32_t MDS_MsgListCrc32(uint32_t crc, const MDS_MsgList_t *msg)
+{
+    crc = ~crc;
+    for (const MDS_MsgList_t *cur = msg; cur != NULL; cur = cur->next) {
+        crc = MSGLIST_Crc32(crc, cur->buff, cur->len);
+    }
+
+    return (~crc);
+}
+
+static uint16_t MSGLIST_Crc16(uint16_t crc, const uint8_t *ptr, size_t len)
+{
+    while (len-- > 0) {
+#if (defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0))
+        crc ^= (uint16_t)(*ptr++) << MDS_BITS_OF_BYTE;
+        crc = (uint16_t)(crc << 4U) ^ G_MSGLIST_CRC16_TABLE[crc >> 12U];
+        crc = (uint16_t)(crc << 4U) ^ G_MSGLIST_CRC16_TABLE[crc >> 12U];
+#else
+        crc = (uint16_t)(crc << MDS_BITS_OF_BYTE) ^
+              G_MSGLIST_CRC16_TABLE[((crc >> MDS_BITS_OF_BYTE) ^ *ptr++) & 0xFFU];
+#endif
+    }
+
+    return (crc);
+}
+
+uint16_t MDS_MsgListCrc16(uint16_t crc, const MDS_MsgList_t *msg)
+{
+    for (const MDS_MsgList_t *cur = msg; cur != NULL; cur = cur->next) {
+        crc = MSGLIST_Crc16(crc, cur->buff, cur->len);
+    }
+
+    return (crc);
+}
+
+static uint32_t MSGLIST_InetFold(uint64_t sum)
+{
+    while ((sum >> 16U) != 0U) {
+        sum = (sum & 0xFFFFU) + (sum >> 16U);
+    }
+
+    return ((uint32_t)sum);
+}
+
+static uint32_t MSGLIST_InetSum(const uint8_t *ptr, size_t len)
+{
+    uint32_t sum = 0;
+
+#if (!(defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0)))
+    // ones' complement sum is byte order independent, add native words and swap once
+    if (MDS_MemAddrIsAligned(ptr, sizeof(uint16_t)) && (len >= sizeof(uint32_t))) {
+        uint64_t acc = 0;
+
+        if (!MDS_MemAddrIsAligned(ptr, sizeof(uint32_t))) {
+            acc += *((const uint16_t *)ptr);
+            ptr += sizeof(uint16_t);
+            len -= sizeof(uint16_t);
+        }
+        while (len >= (sizeof(uint32_t) * 4)) {
+            acc += ((const uint32_t *)ptr)[0];
+            acc += ((const uint32_t *)ptr)[1];
+            acc += ((const uint32_t *)ptr)[2];
+            acc += ((const uint32_t *)ptr)[3];
+            ptr += sizeof(uint32_t) * 4;
+            len -= sizeof(uint32_t) * 4;
+        }
+        while (len >= sizeof(uint32_t)) {
+            acc += *((const uint32_t *)ptr);
+            ptr += sizeof(uint32_t);
+            len -= sizeof(uint32_t);
+        }
+        if (len >= sizeof(uint16_t)) {
+            acc += *((const uint16_t *)ptr);
+            ptr += sizeof(uint16_t);
+            len -= sizeof(uint16_t);
+        }
+
+        sum = MSGLIST_InetFold(acc);
+#if (!(defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)))
+        sum = ((sum & 0xFFU) << MDS_BITS_OF_BYTE) | (sum >> MDS_BITS_OF_BYTE);
+#endif
+    }
+#endif
+
+    for (; len >= sizeof(uint16_t); len -= sizeof(uint16_t)) {
+        sum += ((uint32_t)(ptr[0]) << MDS_BITS_OF_BYTE) | ptr[1];
+        ptr += sizeof(uint16_t);
+        if ((sum & 0x80000000U) != 0U) {
+            sum = MSGLIST_InetFold(sum);
+        }
+    }
+    if (len > 0) {
+        sum += (uint32_t)(ptr[0]) << MDS_BITS_OF_BYTE;
+    }
+
+    return (MSGLIST_InetFold(sum));
+}
+
+uint16_t MDS_MsgListInetChecksum(const MDS_MsgList_t *msg)
+{
+    uint32_t sum = 0;
+    size_t ofs = 0;
+
+    for (const MDS_MsgList_t *cur = msg; cur != NULL; cur = cur->next) {
+        uint32_t part = MSGLIST_InetSum(cur->buff, cur->len);
+        // a segment starting at an odd offset has its byte pairs swapped
+        if ((ofs & 1U) != 0U) {
+            part = ((part & 0xFFU) << MDS_BITS_OF_BYTE) | (part >> MDS_BITS_OF_BYTE);
+        }
+        sum = MSGLIST_InetFold((uint64_t)sum + part);
+        ofs += cur->len;
+    }
+
+    return ((uint16_t)(~sum));
+}
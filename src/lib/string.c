@@ -106,14 +106,45 @@ static unsigned char MDS_StrChar2Hex(const char ch)
     return ((unsigned char)(-1));
 }
 
+#if (!(defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0)))
+static inline bool MDS_StrWordHasZero(size_t word)
+{
+    const size_t ones = ((size_t)(-1)) / 0xFFU;
+    const size_t highs = ones << (MDS_BITS_OF_BYTE - 1);
+
+    return (((word - ones) & (~word) & highs) != 0U);
+}
+#endif
+
 size_t MDS_Strnlen(const char *str, size_t maxlen)
 {
     const char *ch = str;
 
+#if (defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0))
+    while ((maxlen != 0) && (*ch != '\0')) {
+        ch++;
+        maxlen--;
+    }
+#else
+    while ((maxlen != 0) && (!MDS_MemAddrIsAligned(ch, sizeof(size_t)))) {
+        if (*ch == '\0') {
+            return ((size_t)(ch - str));
+        }
+        ch++;
+        maxlen--;
+    }
+
+    // an aligned word never crosses the page where the terminator lies
+    while ((maxlen >= sizeof(size_t)) && (!MDS_StrWordHasZero(*((const size_t *)ch)))) {
+        ch += sizeof(size_t);
+        maxlen -= sizeof(size_t);
+    }
+
     while ((maxlen != 0) && (*ch != '\0')) {
         ch++;
         maxlen--;
     }
+#endif
 
     return ((size_t)(ch - str));
 }
@@ -122,9 +153,26 @@ size_t MDS_Strlen(const char *str)
 {
     const char *ch = str;
 
+#if (defined(CONFIG_MDS_LIBRARY_MINIABLE) && (CONFIG_MDS_LIBRARY_MINIABLE != 0))
+    while (*ch != '\0') {
+        ch++;
+    }
+#else
+    while (!MDS_MemAddrIsAligned(ch, sizeof(size_t))) {
+        if (*ch == '\0') {
+            return ((size_t)(ch - str));
+        }
+        ch++;
+    }
+
+    while (!MDS_StrWordHasZero(*((const size_t *)ch))) {
+        ch += sizeof(size_t);
+    }
+
     while (*ch != '\0') {
         ch++;
     }
+#endif
 
     return (ch - str);
 }
@@ -28,14 +28,10 @@ static void MDS_LOG_ModuleVaPrintf(const MDS_LOG_Module_t *module, uint8_t level
                                    const char *fmt, va_list va_args)
 {
 #if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
-    if ((module != NULL) && (module->filter != NULL)) {
-        if (level > module->filter->level) {
-            return;
-        }
-        if (module->filter->backend != NULL) {
-            module->filter->backend(module, level, va_size, fmt, va_args);
-            return;
-        }
+    // level has been checked at the call site
+    if ((module != NULL) && (module->filter != NULL) && (module->filter->backend != NULL)) {
+        module->filter->backend(module, level, va_size, fmt, va_args);
+        return;
     }
 #endif
     if (g_logVaPrintFunc != NULL) {
@@ -53,6 +49,78 @@ void MDS_LOG_ModulePrintf(const MDS_LOG_Module_t *module, uint8_t level, size_t
     va_end(va_args);
 }
 
+#if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
+static __attribute__((used, section(CONFIG_MDS_LOG_MODULE_SECTION " ")))
+MDS_LOG_Module_t *const g_logModuleBegin = NULL;
+static __attribute__((used, section(CONFIG_MDS_LOG_MODULE_SECTION "~")))
+MDS_LOG_Module_t *const g_logModuleLimit = NULL;
+
+static bool LOG_ModuleNameIs(const MDS_LOG_Module_t *module, const char *name)
+{
+    const char *str = module->name;
+
+    while ((*str != '\0') && (*str == *name)) {
+        str++;
+        name++;
+    }
+
+    return (*str == *name);
+}
+
+void MDS_LOG_ModuleForeach(void (*entry)(MDS_LOG_Module_t *module, MDS_Arg_t *arg),
+                           MDS_Arg_t *arg)
+{
+    MDS_ASSERT(entry != NULL);
+
+    for (MDS_LOG_Module_t *const *module = &g_logModuleBegin + 1; module < &g_logModuleLimit;
+         module++) {
+        if (*module != NULL) {
+            entry(*module, arg);
+        }
+    }
+}
+
+MDS_LOG_Module_t *MDS_LOG_ModuleFind(const char *name)
+{
+    MDS_ASSERT(name != NULL);
+
+    for (MDS_LOG_Module_t *const *module = &g_logModuleBegin + 1; module < &g_logModuleLimit;
+         module++) {
+        if ((*module != NULL) && LOG_ModuleNameIs(*module, name)) {
+            return (*module);
+        }
+    }
+
+    return (NULL);
+}
+
+MDS_Err_t MDS_LOG_ModuleSetLevel(const char *name, uint8_t level)
+{
+    if (level > MDS_LOG_LEVEL_DBG) {
+        return (MDS_EINVAL);
+    }
+
+    // all registered modules when no name
+    if (name == NULL) {
+        for (MDS_LOG_Module_t *const *module = &g_logModuleBegin + 1;
+             module < &g_logModuleLimit; module++) {
+            if (*module != NULL) {
+                (*module)->level = level;
+            }
+        }
+        return (MDS_EOK);
+    }
+
+    MDS_LOG_Module_t *module = MDS_LOG_ModuleFind(name);
+    if (module == NULL) {
+        return (MDS_ENOENT);
+    }
+    module->level = level;
+
+    return (MDS_EOK);
+}
+#endif
+
 __attribute__((weak, noreturn)) void MDS_CorePanicTrace(void)
 {
     for (;;) {
@@ -75,64 +143,106 @@ __attribute__((noreturn)) void MDS_PanicPrintf(size_t va_size, const char *fmt,
     MDS_CorePanicTrace();
 }
 
-#if 0
+#if (defined(CONFIG_MDS_LOG_COMPRESS_ENABLE) && (CONFIG_MDS_LOG_COMPRESS_ENABLE != 0))
 /* Compress ---------------------------------------------------------------- */
-#ifndef MDS_LOG_COMPRESS_ARGS_NUMS
-#define MDS_LOG_COMPRESS_ARGS_NUMS 7
+#ifndef CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE
+#define CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE 1024
 #endif
 
-#ifndef MDS_LOG_COMPRESS_MAGIC
-#define MDS_LOG_COMPRESS_MAGIC 0xD6 /* log 109 => 0x6D */
-#endif
-
-#ifndef MDS_LOG_COMPRESS_ARG_FIX
-/* 0xFFFFFFFF => -1111111111 (2's complement: 0xBDC5CA39) */
-#define MDS_LOG_COMPRESS_ARG_FIX(x) ((x == 0xFFFFFFFF) ? (0xBDC5CA39) : (x))
-#endif
+static struct {
+    size_t head;  // next byte to write
+    size_t tail;  // next byte to read
+    size_t dropped;
+    uint16_t psn;
+    MDS_SpinLock_t spinlock;
+    uint8_t buff[CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE];
+} g_logCompress;
 
-size_t MDS_LOG_CompressStructVa(MDS_LOG_Compress_t *log, size_t level, size_t cnt,
-                                const char *fmt, va_list ap)
+static void LOG_CompressCopyIn(size_t pos, const void *data, size_t size)
 {
-    static size_t logCompressPsn = 0;
-
-    if (log == NULL) {
-        return (0);
+    size_t ofs = pos % CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE;
+    size_t len = CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE - ofs;
+
+    if (len >= size) {
+        MDS_MemBuffCopy(&(g_logCompress.buff[ofs]), size, data, size);
+    } else {
+        MDS_MemBuffCopy(&(g_logCompress.buff[ofs]), len, data, len);
+        MDS_MemBuffCopy(g_logCompress.buff, size - len, (const uint8_t *)data + len, size - len);
     }
+}
 
-    // atomic
-    MDS_Lock_t lock = MDS_KernelEnterCritical();
-    logCompressPsn++;
-    MDS_KernelExitCritical(lock);
-
-    if (cnt > MDS_LOG_COMPRESS_ARGS_NUMS) {
-        cnt = MDS_LOG_COMPRESS_ARGS_NUMS;
+static void LOG_CompressCopyOut(size_t pos, void *data, size_t size)
+{
+    size_t ofs = pos % CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE;
+    size_t len = CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE - ofs;
+
+    if (len >= size) {
+        MDS_MemBuffCopy(data, size, &(g_logCompress.buff[ofs]), size);
+    } else {
+        MDS_MemBuffCopy(data, len, &(g_logCompress.buff[ofs]), len);
+        MDS_MemBuffCopy((uint8_t *)data + len, size - len, g_logCompress.buff, size - len);
     }
+}
 
-    log->magic = MDS_LOG_COMPRESS_MAGIC;
-    log->address = (uintptr_t)fmt & 0x00FFFFFF;
-    log->level = level;
-    log->count = cnt;
-    log->psn = logCompressPsn;
-    log->timestamp = MDS_ClockGetTimestamp(NULL);
-
-    for (size_t idx = 0; idx < cnt; idx++) {
-        uint32_t val = va_arg(ap, uint32_t);
-        log->args[idx] = MDS_LOG_COMPRESS_ARG_FIX(val);
+void MDS_LOG_CompressWrite(const MDS_LOG_Module_t *module, uint8_t level, const char *fmt,
+                           const void *args, size_t size)
+{
+    UNUSED(module);
+
+    MDS_LOG_Compress_t log = {
+        .magic = MDS_LOG_COMPRESS_MAGIC,
+        .level = level,
+        .size = size,
+        .address = (uintptr_t)fmt,
+        .timestamp = MDS_ClockGetTickCount(),
+    };
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_logCompress.spinlock));
+
+    // keep older records when full, the host sees the gap from psn
+    log.psn = g_logCompress.psn++;
+    if ((size > UINT8_MAX) ||
+        ((sizeof(log) + size) >
+         (CONFIG_MDS_LOG_COMPRESS_BUFF_SIZE - (g_logCompress.head - g_logCompress.tail)))) {
+        g_logCompress.dropped += 1;
+    } else {
+        LOG_CompressCopyIn(g_logCompress.head, &log, sizeof(log));
+        if (size != 0) {
+            LOG_CompressCopyIn(g_logCompress.head + sizeof(log), args, size);
+        }
+        g_logCompress.head += sizeof(log) + size;
     }
 
-    return (sizeof(MDS_LOG_Compress_t) -
-            (sizeof(uint32_t) * (MDS_LOG_COMPRESS_ARGS_NUMS + cnt)));
+    MDS_CriticalRestore(&(g_logCompress.spinlock), lock);
 }
 
-size_t MDS_LOG_CompressSturctPrint(MDS_LOG_Compress_t *log, size_t level, size_t cnt,
-                                   const char *fmt, ...)
+size_t MDS_LOG_CompressRead(void *buff, size_t size)
 {
-    va_list ap;
+    MDS_ASSERT(buff != NULL);
+
+    size_t len = 0;
 
-    va_start(ap, fmt);
-    size_t len = MDS_LOG_CompressStructVa(log, level, cnt, fmt, ap);
-    va_end(ap);
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_logCompress.spinlock));
+
+    // whole records only
+    while (g_logCompress.tail != g_logCompress.head) {
+        MDS_LOG_Compress_t log;
+        LOG_CompressCopyOut(g_logCompress.tail, &log, sizeof(log));
+        if ((len + sizeof(log) + log.size) > size) {
+            break;
+        }
+        LOG_CompressCopyOut(g_logCompress.tail, (uint8_t *)buff + len, sizeof(log) + log.size);
+        g_logCompress.tail += sizeof(log) + log.size;
+        len += sizeof(log) + log.size;
+    }
+
+    MDS_CriticalRestore(&(g_logCompress.spinlock), lock);
 
     return (len);
 }
+
+size_t MDS_LOG_CompressDropped(void)
+{
+    return (g_logCompress.dropped);
+}
 #endif
@@ -87,7 +87,7 @@ MDS_Err_t MDS_SemaphoreRelease(MDS_Semaphore_t *semaphore)
     MDS_Err_t err = MDS_EOK;
 
     MDS_Lock_t lock = MDS_CoreInterruptLock();
-    if (semaphore->value < semaphore->max) {
+    if ((semaphore->value < 0) || ((size_t)semaphore->value < semaphore->max)) {
         semaphore->value += 1;
     } else {
         err = MDS_ERANGE;
@@ -117,6 +117,7 @@ MDS_Err_t MDS_MutexInit(MDS_Mutex_t *mutex, const char *name)
     if (err == MDS_EOK) {
         mutex->owner = NULL;
         mutex->priority.priority = CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX;
+        mutex->ceiling.priority = CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX;
         mutex->value = 1;
         mutex->nest = 0;
     }
@@ -124,6 +125,16 @@ MDS_Err_t MDS_MutexInit(MDS_Mutex_t *mutex, const char *name)
     return (err);
 }
 
+MDS_Err_t MDS_MutexInitCeiling(MDS_Mutex_t *mutex, const char *name, MDS_ThreadPriority_t ceiling)
+{
+    MDS_Err_t err = MDS_MutexInit(mutex, name);
+    if (err == MDS_EOK) {
+        mutex->ceiling = ceiling;
+    }
+
+    return (err);
+}
+
 MDS_Err_t MDS_MutexDeInit(MDS_Mutex_t *mutex)
 {
     MDS_ASSERT(mutex != NULL);
@@ -139,6 +150,7 @@ MDS_Mutex_t *MDS_MutexCreate(const char *name)
     if (mutex != NULL) {
         mutex->owner = NULL;
         mutex->priority.priority = CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX;
+        mutex->ceiling.priority = CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX;
         mutex->value = 1;
         mutex->nest = 0;
     }
@@ -146,6 +158,16 @@ MDS_Mutex_t *MDS_MutexCreate(const char *name)
     return (mutex);
 }
 
+MDS_Mutex_t *MDS_MutexCreateCeiling(const char *name, MDS_ThreadPriority_t ceiling)
+{
+    MDS_Mutex_t *mutex = MDS_MutexCreate(name);
+    if (mutex != NULL) {
+        mutex->ceiling = ceiling;
+    }
+
+    return (mutex);
+}
+
 MDS_Err_t MDS_MutexDestroy(MDS_Mutex_t *mutex)
 {
     MDS_ASSERT(mutex != NULL);
@@ -198,6 +220,35 @@ MDS_Thread_t *MDS_MutexGetOwner(const MDS_Mutex_t *mutex)
     return (mutex->owner);
 }
 
+/* SeqLock ----------------------------------------------------------------- */
+void MDS_SeqLockInit(MDS_SeqLock_t *seqlock)
+{
+    MDS_ASSERT(seqlock != NULL);
+
+    MDS_AtomicStore(&(seqlock->sequence), 0);
+}
+
+MDS_Lock_t MDS_SeqLockWriteBegin(MDS_SeqLock_t *seqlock)
+{
+    MDS_ASSERT(seqlock != NULL);
+
+    MDS_Lock_t lock = MDS_CoreInterruptLock();
+
+    MDS_AtomicStore(&(seqlock->sequence), MDS_AtomicLoad(&(seqlock->sequence)) + 1);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    return (lock);
+}
+
+void MDS_SeqLockWriteEnd(MDS_SeqLock_t *seqlock, MDS_Lock_t lock)
+{
+    MDS_ASSERT(seqlock != NULL);
+
+    MDS_AtomicStore(&(seqlock->sequence), MDS_AtomicLoad(&(seqlock->sequence)) + 1);
+
+    MDS_CoreInterruptRestore(lock);
+}
+
 /* Event ------------------------------------------------------------------- */
 MDS_Err_t MDS_EventInit(MDS_Event_t *event, const char *name)
 {
@@ -287,6 +338,11 @@ MDS_Err_t MDS_EventSet(MDS_Event_t *event, MDS_Mask_t mask)
     return (MDS_EOK);
 }
 
+MDS_Err_t MDS_EventBroadcast(MDS_Event_t *event, MDS_Mask_t mask)
+{
+    return (MDS_EventSet(event, mask));
+}
+
 MDS_Err_t MDS_EventClr(MDS_Event_t *event, MDS_Mask_t mask)
 {
     MDS_ASSERT(event != NULL);
@@ -352,6 +408,15 @@ static void TIMER_SkipListInsert(MDS_WorkQueue_t *workq, MDS_Timer_t *timer, MDS
     MDS_SkipListSearchNode(skipNode, workq->list, ARRAY_SIZE(workq->list), timer,
                            TIMER_SkipListCompare);
 
+    const MDS_DListNode_t *last = skipNode[ARRAY_SIZE(timer->node) - 1];
+    if ((timer->tslack > 0) && (last->next != &(workq->list[ARRAY_SIZE(timer->node) - 1]))) {
+        const MDS_Timer_t *timerl = CONTAINER_OF(last->next, MDS_Timer_t,
+                                                 node[ARRAY_SIZE(timer->node) - 1]);
+        if ((timerl->tickout - timer->tickout) <= timer->tslack) {
+            timer->tickout = timerl->tickout;
+        }
+    }
+
     skipRand = skipRand + tickcurr + 1;
     MDS_SkipListInsertNode(skipNode, timer->node, ARRAY_SIZE(timer->node), skipRand,
                            CONFIG_MDS_TIMER_SKIPLIST_SHIFT);
@@ -514,6 +579,20 @@ MDS_Err_t MDS_TimerStop(MDS_Timer_t *timer)
     return (MDS_EOK);
 }
 
+MDS_Err_t MDS_TimerSetSlack(MDS_Timer_t *timer, MDS_Timeout_t slack)
+{
+    MDS_ASSERT(timer != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(timer->object)) == MDS_OBJECT_TYPE_WORKNODE);
+
+    if (slack.ticks >= MDS_CLOCK_TICK_TIMER_MAX) {
+        return (MDS_EINVAL);
+    }
+
+    timer->tslack = slack.ticks;
+
+    return (MDS_EOK);
+}
+
 bool MDS_TimerIsActive(const MDS_Timer_t *timer)
 {
     MDS_ASSERT(timer != NULL);
@@ -17,17 +17,20 @@
 
 /* Variable ---------------------------------------------------------------- */
 static MDS_ObjectInfo_t g_objectList[] = {
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_DEVICE),     //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_THREAD),     //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_WORKQUEUE),  //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_WORKNODE),   //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_SEMAPHORE),  //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MUTEX),      //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_EVENT),      //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_POLL),       //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MSGQUEUE),   //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MEMPOOL),    //
-    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MEMHEAP),    //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_DEVICE),      //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_THREAD),      //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_THREADPOOL),  //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_WORKQUEUE),   //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_WORKNODE),    //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_SEMAPHORE),   //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_CONDITION),   //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MUTEX),       //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_RWLOCK),      //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_EVENT),       //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_POLL),        //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MSGQUEUE),    //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MEMPOOL),     //
+    OBJECT_LIST_INIT(MDS_OBJECT_TYPE_MEMHEAP),     //
 };
 
 /* Function ---------------------------------------------------------------- */
@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) [2022] [pchom]
+ * [MDS] is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ **/
+/* Include ----------------------------------------------------------------- */
+#include "kernel.h"
+
+/* Define ------------------------------------------------------------------ */
+MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
+
+// ipc awaits retry once per interval, each waiting task then runs and wakes tickless idle,
+// a producer calls MDS_AsyncWakeup for a prompt retry
+#ifndef CONFIG_MDS_ASYNC_POLL_TICKS
+#define CONFIG_MDS_ASYNC_POLL_TICKS 10
+#endif
+
+/* Function ---------------------------------------------------------------- */
+static void ASYNC_WorkEntry(const MDS_WorkNode_t *workn, MDS_Arg_t *arg)
+{
+    MDS_Async_t *async = (MDS_Async_t *)arg;
+
+    UNUSED(workn);
+
+    MDS_AsyncState_t state = async->entry(async, async->arg);
+    if (state == MDS_ASYNC_STATE_EXITED) {
+        MDS_LOG_D("[async] async(%p) entry:%p exited", async, async->entry);
+
+        MDS_WorkNodeCancle(&(async->workn));
+    }
+}
+
+static void ASYNC_Submit(MDS_Async_t *async, MDS_Tick_t ticks)
+{
+    MDS_WorkNodeSubmit(async->workq, &(async->workn), MDS_TIMEOUT_TICKS(ticks),
+                       MDS_TIMEOUT_NO_WAIT);
+}
+
+MDS_Err_t MDS_AsyncInit(MDS_Async_t *async, const char *name, MDS_WorkQueue_t *workq,
+                        MDS_AsyncEntry_t entry, MDS_Arg_t *arg)
+{
+    MDS_ASSERT(async != NULL);
+    MDS_ASSERT(workq != NULL);
+    MDS_ASSERT(entry != NULL);
+
+    MDS_Err_t err = MDS_WorkNodeInit(&(async->workn), name, ASYNC_WorkEntry, NULL,
+                                     (MDS_Arg_t *)async);
+    if (err == MDS_EOK) {
+        // polling awaits of different tasks share wakeups
+        MDS_WorkNodeSetSlack(&(async->workn), MDS_TIMEOUT_TICKS(CONFIG_MDS_ASYNC_POLL_TICKS));
+        async->workq = workq;
+        async->entry = entry;
+        async->arg = arg;
+        async->line = 0;
+        async->wakeup = false;
+    }
+
+    return (err);
+}
+
+MDS_Err_t MDS_AsyncDeInit(MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    return (MDS_WorkNodeDeInit(&(async->workn)));
+}
+
+MDS_Err_t MDS_AsyncStart(MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    if (MDS_WorkNodeIsSubmit(&(async->workn))) {
+        return (MDS_EBUSY);
+    }
+
+    async->line = 0;
+    async->err = MDS_EOK;
+
+    return (MDS_WorkNodeSubmit(async->workq, &(async->workn), MDS_TIMEOUT_NO_WAIT,
+                               MDS_TIMEOUT_NO_WAIT));
+}
+
+MDS_Err_t MDS_AsyncStop(MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    MDS_Err_t err = MDS_WorkNodeCancle(&(async->workn));
+    if (err == MDS_EOK) {
+        async->line = 0;
+    }
+
+    return (err);
+}
+
+MDS_Err_t MDS_AsyncWakeup(MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    if (!MDS_WorkNodeIsSubmit(&(async->workn))) {
+        return (MDS_EAGAIN);
+    }
+
+    async->wakeup = true;
+
+    return (MDS_WorkNodeSubmit(async->workq, &(async->workn), MDS_TIMEOUT_NO_WAIT,
+                               MDS_TIMEOUT_NO_WAIT));
+}
+
+bool MDS_AsyncIsRunning(const MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    return (MDS_WorkNodeIsSubmit(&(async->workn)));
+}
+
+MDS_AsyncState_t MDS_AsyncYield(MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    ASYNC_Submit(async, MDS_CLOCK_TICK_NO_WAIT);
+
+    return (MDS_ASYNC_STATE_WAITING);
+}
+
+void MDS_AsyncAwaitBegin(MDS_Async_t *async, MDS_Timeout_t timeout)
+{
+    MDS_ASSERT(async != NULL);
+
+    async->tickwait = timeout.ticks;
+    async->tickout = MDS_ClockGetTickCount() + timeout.ticks;
+    async->wakeup = false;
+}
+
+static MDS_Tick_t ASYNC_AwaitRemain(const MDS_Async_t *async)
+{
+    if (async->tickwait == MDS_CLOCK_TICK_FOREVER) {
+        return (MDS_CLOCK_TICK_FOREVER);
+    }
+
+    MDS_Tick_t remain = async->tickout - MDS_ClockGetTickCount();
+
+    return ((remain < MDS_CLOCK_TICK_TIMER_MAX) ? (remain) : (0));
+}
+
+bool MDS_AsyncAwaitCheck(MDS_Async_t *async, MDS_Err_t err)
+{
+    MDS_ASSERT(async != NULL);
+
+    if (err == MDS_ETIMEOUT) {
+        MDS_Tick_t remain = ASYNC_AwaitRemain(async);
+        if (remain > 0) {
+            ASYNC_Submit(async, (remain < CONFIG_MDS_ASYNC_POLL_TICKS) ?
+                                    (remain) : (CONFIG_MDS_ASYNC_POLL_TICKS));
+            return (false);
+        }
+    }
+
+    async->err = err;
+
+    return (true);
+}
+
+bool MDS_AsyncDelayCheck(MDS_Async_t *async)
+{
+    MDS_ASSERT(async != NULL);
+
+    MDS_Tick_t remain = ASYNC_AwaitRemain(async);
+    if ((remain == 0) || (async->wakeup)) {
+        async->wakeup = false;
+        async->err = MDS_EOK;
+        return (true);
+    }
+
+    // delay forever until wakeup or stop
+    if (remain != MDS_CLOCK_TICK_FOREVER) {
+        ASYNC_Submit(async, remain);
+    }
+
+    return (false);
+}
@@ -41,7 +41,9 @@ void MDS_ClockIncTickCount(MDS_Tick_t ticks)
 
     MDS_CriticalRestore(&(g_sysTick.spinlock), lock);
 
+    MDS_KernelCpuAccount();
     MDS_ThreadRemainTicks(ticks);
 
+    MDS_ThreadTimeoutCheck();
     MDS_SysTimerCheck();
 }
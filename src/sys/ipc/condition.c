@@ -16,28 +16,48 @@
 MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 
 /* Function ---------------------------------------------------------------- */
+static bool CONDITION_WakeWaiter(MDS_Condition_t *condition)
+{
+    MDS_Thread_t *thread = MDS_KernelWaitQueuePeek(&(condition->queueWait));
+    if (thread == NULL) {
+        return (false);
+    }
+
+    // timeout only covers the condition wait, mutex re-acquire is unbounded
+    MDS_ThreadTimeoutStop(thread);
+    MDS_KernelWaitQueueRemove(thread);
+
+    if (MDS_MutexMorphWaiter(condition->mutex, thread)) {
+        MDS_ThreadResume(thread);
+    }
+
+    return (true);
+}
+
 MDS_Err_t MDS_ConditionInit(MDS_Condition_t *condition, const char *name)
 {
     MDS_ASSERT(condition != NULL);
 
-    return (MDS_SemaphoreInit(condition, name, 0, -1));
+    MDS_Err_t err = MDS_ObjectInit(&(condition->object), MDS_OBJECT_TYPE_CONDITION, name);
+    if (err == MDS_EOK) {
+        condition->mutex = NULL;
+        MDS_KernelWaitQueueInit(&(condition->queueWait));
+        MDS_SpinLockInit(&(condition->spinlock));
+    }
+
+    return (err);
 }
 
 MDS_Err_t MDS_ConditionDeInit(MDS_Condition_t *condition)
 {
     MDS_ASSERT(condition != NULL);
-    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_SEMAPHORE);
+    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_CONDITION);
 
     MDS_Err_t err = MDS_EBUSY;
 
     MDS_Lock_t lock = MDS_CriticalLock(&(condition->spinlock));
 
     if (MDS_KernelWaitQueuePeek(&(condition->queueWait)) == NULL) {
-        while (MDS_SemaphoreAcquire(condition, MDS_TIMEOUT_NO_WAIT) == MDS_EBUSY) {
-            MDS_ConditionBroadCast(condition);
-        }
-
-        MDS_KernelWaitQueueDrain(&(condition->queueWait));
         err = MDS_ObjectDeInit(&(condition->object));
     }
 
@@ -48,24 +68,28 @@ MDS_Err_t MDS_ConditionDeInit(MDS_Condition_t *condition)
 
 MDS_Condition_t *MDS_ConditionCreate(const char *name)
 {
-    return (MDS_SemaphoreCreate(name, 0, -1));
+    MDS_Condition_t *condition = (MDS_Condition_t *)MDS_ObjectCreate(sizeof(MDS_Condition_t),
+                                                                     MDS_OBJECT_TYPE_CONDITION,
+                                                                     name);
+    if (condition != NULL) {
+        condition->mutex = NULL;
+        MDS_KernelWaitQueueInit(&(condition->queueWait));
+        MDS_SpinLockInit(&(condition->spinlock));
+    }
+
+    return (condition);
 }
 
 MDS_Err_t MDS_ConditionDestroy(MDS_Condition_t *condition)
 {
     MDS_ASSERT(condition != NULL);
-    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_SEMAPHORE);
+    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_CONDITION);
 
     MDS_Err_t err = MDS_EBUSY;
 
     MDS_Lock_t lock = MDS_CriticalLock(&(condition->spinlock));
 
     if (MDS_KernelWaitQueuePeek(&(condition->queueWait)) == NULL) {
-        while (MDS_SemaphoreAcquire(condition, MDS_TIMEOUT_NO_WAIT) == MDS_EBUSY) {
-            MDS_ConditionBroadCast(condition);
-        }
-
-        MDS_KernelWaitQueueDrain(&(condition->queueWait));
         err = MDS_ObjectDestroy(&(condition->object));
     }
 
@@ -77,43 +101,47 @@ MDS_Err_t MDS_ConditionDestroy(MDS_Condition_t *condition)
 MDS_Err_t MDS_ConditionBroadCast(MDS_Condition_t *condition)
 {
     MDS_ASSERT(condition != NULL);
-    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_SEMAPHORE);
+    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_CONDITION);
 
-    MDS_Err_t err;
-    do {
-        err = MDS_SemaphoreAcquire(condition, MDS_TIMEOUT_NO_WAIT);
-        if ((err == MDS_ETIMEOUT) || (err == MDS_EOK)) {
-            MDS_SemaphoreRelease(condition);
-        }
-    } while (err == MDS_ETIMEOUT);
+    bool reSchedule = false;
 
-    return (err);
+    MDS_Lock_t lock = MDS_CriticalLock(&(condition->spinlock));
+
+    while (CONDITION_WakeWaiter(condition)) {
+        reSchedule = true;
+    }
+
+    MDS_CriticalRestore(&(condition->spinlock), lock);
+
+    if (reSchedule) {
+        MDS_KernelSchedulerCheck();
+    }
+
+    return (MDS_EOK);
 }
 
 MDS_Err_t MDS_ConditionSignal(MDS_Condition_t *condition)
 {
     MDS_ASSERT(condition != NULL);
-    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_SEMAPHORE);
-
-    MDS_Err_t err = MDS_EOK;
+    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_CONDITION);
 
     MDS_Lock_t lock = MDS_CriticalLock(&(condition->spinlock));
 
-    MDS_Thread_t *thread = MDS_KernelWaitQueuePeek(&(condition->queueWait));
+    bool reSchedule = CONDITION_WakeWaiter(condition);
 
     MDS_CriticalRestore(&(condition->spinlock), lock);
 
-    if (thread != NULL) {
-        err = MDS_SemaphoreRelease(condition);
+    if (reSchedule) {
+        MDS_KernelSchedulerCheck();
     }
 
-    return (err);
+    return (MDS_EOK);
 }
 
 MDS_Err_t MDS_ConditionWait(MDS_Condition_t *condition, MDS_Mutex_t *mutex, MDS_Timeout_t timeout)
 {
     MDS_ASSERT(condition != NULL);
-    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_SEMAPHORE);
+    MDS_ASSERT(MDS_ObjectGetType(&(condition->object)) == MDS_OBJECT_TYPE_CONDITION);
     MDS_ASSERT(mutex != NULL);
     MDS_ASSERT(MDS_ObjectGetType(&(mutex->object)) == MDS_OBJECT_TYPE_MUTEX);
 
@@ -124,27 +152,37 @@ MDS_Err_t MDS_ConditionWait(MDS_Condition_t *condition, MDS_Mutex_t *mutex, MDS_
         return (MDS_EACCES);
     }
 
+    if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+        return (thread->err = MDS_ETIMEOUT);
+    } else if (!MDS_KernelWaitQueueTimeout(timeout)) {
+        return (MDS_EINVAL);
+    }
+
     MDS_Lock_t lock = MDS_CriticalLock(&(condition->spinlock));
 
-    if (condition->value > 0) {
-        condition->value -= 1;
-    } else if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
-        err = thread->err = MDS_ETIMEOUT;
-    } else if ((timeout.ticks < MDS_CLOCK_TICK_TIMER_MAX) && (thread != NULL)) {
-        err = MDS_KernelWaitQueueSuspend(&(condition->queueWait), thread, timeout, false);
+    MDS_ASSERT((condition->mutex == NULL) || (condition->mutex == mutex) ||
+               (MDS_KernelWaitQueuePeek(&(condition->queueWait)) == NULL));
+    condition->mutex = mutex;
+
+    thread->err = MDS_EOK;
+    err = MDS_KernelWaitQueueSuspend(&(condition->queueWait), thread, timeout, true);
+    if (err == MDS_EOK) {
         MDS_MutexRelease(mutex);
+    }
+
+    MDS_CriticalRestore(&(condition->spinlock), lock);
 
-        MDS_CriticalRestore(&(condition->spinlock), lock);
+    if (err == MDS_EOK) {
+        MDS_KernelSchedulerCheck();
+        err = thread->err;
 
-        if (err == MDS_EOK) {
-            MDS_KernelSchedulerCheck();
-            err = thread->err;
+        // woken by signal the mutex is handed over, only timeout has to take it back
+        if (mutex->owner != thread) {
+            MDS_Err_t ret = MDS_MutexAcquire(mutex, MDS_TIMEOUT_FOREVER);
+            if (ret != MDS_EOK) {
+                err = ret;  // caller is not holding the mutex
+            }
         }
-
-        MDS_MutexAcquire(mutex, MDS_TIMEOUT_FOREVER);
-    } else {
-        MDS_CriticalRestore(&(condition->spinlock), lock);
-        err = MDS_EINVAL;
     }
 
     return (err);
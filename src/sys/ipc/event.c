@@ -16,6 +16,20 @@
 MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 
 /* Function ---------------------------------------------------------------- */
+static bool EVENT_WaiterMatch(MDS_Thread_t *thread, MDS_Mask_t value)
+{
+    if ((thread->eventOpt & MDS_EVENT_OPT_AND) != 0U) {
+        return ((thread->eventMask & value) == thread->eventMask);
+    } else if ((thread->eventOpt & MDS_EVENT_OPT_OR) != 0U) {
+        if ((thread->eventMask & value) != 0U) {
+            thread->eventMask &= value;
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
 MDS_Err_t MDS_EventInit(MDS_Event_t *event, const char *name)
 {
     MDS_ASSERT(event != NULL);
@@ -108,7 +122,7 @@ MDS_Err_t MDS_EventWait(MDS_Event_t *event, MDS_Mask_t wait, MDS_EventOpt_t opt,
         }
     } else if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
         err = thread->err = MDS_ETIMEOUT;
-    } else if ((timeout.ticks < MDS_CLOCK_TICK_TIMER_MAX) && (thread != NULL)) {
+    } else if (MDS_KernelWaitQueueTimeout(timeout) && (thread != NULL)) {
         thread->eventMask = wait;
         thread->eventOpt = opt;
         err = MDS_KernelWaitQueueSuspend(&(event->queueWait), thread, timeout, true);
@@ -145,7 +159,7 @@ MDS_Err_t MDS_EventSet(MDS_Event_t *event, MDS_Mask_t set)
     MDS_LOG_D("[event] event(%p) which value:%zx set mask:%zx", event, event->value, set);
 
     MDS_HOOK_CALL(KERNEL, event,
-                  (event, MDS_KERNEL_TRACE_EVENT_HAS_SET, err, MDS_TIMEOUT_TICKS(mask)));
+                  (event, MDS_KERNEL_TRACE_EVENT_HAS_SET, err, MDS_TIMEOUT_TICKS(set)));
 
     MDS_Lock_t lock = MDS_CriticalLock(&(event->spinlock));
 
@@ -153,24 +167,16 @@ MDS_Err_t MDS_EventSet(MDS_Event_t *event, MDS_Mask_t set)
     MDS_Thread_t *iter = NULL;
     MDS_DLIST_FOREACH_NEXT (iter, nodeWait.node, &(event->queueWait.list)) {
         err = MDS_EINVAL;
-        if ((iter->eventOpt & MDS_EVENT_OPT_AND) != 0U) {
-            if ((iter->eventMask & event->value) == iter->eventMask) {
-                err = MDS_EOK;
-            }
-        } else if ((iter->eventOpt & MDS_EVENT_OPT_OR) != 0U) {
-            if ((iter->eventMask & event->value) != 0U) {
-                iter->eventMask &= event->value;
-                err = MDS_EOK;
-            }
-        } else {
+        if ((iter->eventOpt & (MDS_EVENT_OPT_AND | MDS_EVENT_OPT_OR)) == 0U) {
             break;
         }
-        if (err == MDS_EOK) {
+        if (EVENT_WaiterMatch(iter, event->value)) {
             if ((iter->eventOpt & MDS_EVENT_OPT_NOCLR) == 0U) {
                 event->value &= ~iter->eventMask;
             }
-            MDS_KernelWaitQueueResume(&(event->queueWait));
+            MDS_ThreadResume(iter);
             reSchedule = true;
+            err = MDS_EOK;
             break;
         }
     }
@@ -184,6 +190,48 @@ MDS_Err_t MDS_EventSet(MDS_Event_t *event, MDS_Mask_t set)
     return (err);
 }
 
+MDS_Err_t MDS_EventBroadcast(MDS_Event_t *event, MDS_Mask_t set)
+{
+    MDS_ASSERT(event != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(event->object)) == MDS_OBJECT_TYPE_EVENT);
+
+    MDS_Err_t err = MDS_EOK;
+    bool reSchedule = false;
+    MDS_Mask_t clr = 0U;
+
+    MDS_LOG_D("[event] event(%p) which value:%zx broadcast mask:%zx", event, event->value, set);
+
+    MDS_HOOK_CALL(KERNEL, event,
+                  (event, MDS_KERNEL_TRACE_EVENT_HAS_SET, err, MDS_TIMEOUT_TICKS(set)));
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(event->spinlock));
+
+    // every waiter sees the same value, bits consumed are cleared after the whole scan
+    event->value |= set;
+    MDS_DListNode_t *node = event->queueWait.list.next;
+    while (node != &(event->queueWait.list)) {
+        MDS_Thread_t *iter = CONTAINER_OF(node, MDS_Thread_t, nodeWait.node);
+        node = node->next;
+
+        if (EVENT_WaiterMatch(iter, event->value)) {
+            if ((iter->eventOpt & MDS_EVENT_OPT_NOCLR) == 0U) {
+                clr |= iter->eventMask;
+            }
+            MDS_ThreadResume(iter);
+            reSchedule = true;
+        }
+    }
+    event->value &= ~clr;
+
+    MDS_CriticalRestore(&(event->spinlock), lock);
+
+    if (reSchedule) {
+        MDS_KernelSchedulerCheck();
+    }
+
+    return (err);
+}
+
 MDS_Err_t MDS_EventClr(MDS_Event_t *event, MDS_Mask_t clr)
 {
     MDS_ASSERT(event != NULL);
@@ -194,7 +242,7 @@ MDS_Err_t MDS_EventClr(MDS_Event_t *event, MDS_Mask_t clr)
     MDS_LOG_D("[event] event(%p) which value:%zx clr mask:%zx", event, event->value, clr);
 
     MDS_HOOK_CALL(KERNEL, event,
-                  (event, MDS_KERNEL_TRACE_EVENT_HAS_CLR, err, (MDS_Timeout_t) {.ticks = mask}));
+                  (event, MDS_KERNEL_TRACE_EVENT_HAS_CLR, err, MDS_TIMEOUT_TICKS(clr)));
 
     MDS_Lock_t lock = MDS_CriticalLock(&(event->spinlock));
     event->value &= ~(clr);
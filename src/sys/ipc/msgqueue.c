@@ -349,7 +349,8 @@ MDS_Err_t MDS_MsgQueueUrgentMsg(MDS_MsgQueue_t *msgQueue, const MDS_MsgList_t *m
     MDS_CriticalRestore(&(msgQueue->spinlock), lock);
 
     MDS_HOOK_CALL(KERNEL, msgqueue,
-                  (msgQueue, MDS_KERNEL_TRACE_MSGQUEUE_HAS_SEND, err, MDS_TIMEOUT_NO_WAIT));
+                  (msgQueue, MDS_KERNEL_TRACE_MSGQUEUE_HAS_SEND,
+                   (msg != NULL) ? (MDS_EOK) : (MDS_ERANGE), MDS_TIMEOUT_NO_WAIT));
 
     if (msg == NULL) {
         return (MDS_ERANGE);
@@ -16,18 +16,111 @@
 MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 
 /* Function ---------------------------------------------------------------- */
+static void MUTEX_UpdatePriority(MDS_Mutex_t *mutex)
+{
+    MDS_Thread_t *waiter = MDS_KernelWaitQueuePeek(&(mutex->queueWait));
+
+    mutex->priority = (waiter != NULL)
+                          ? (waiter->currPrio)
+                          : (MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX));
+}
+
+static MDS_ThreadPriority_t MUTEX_InheritPriority(const MDS_Thread_t *thread)
+{
+    MDS_ThreadPriority_t priority = thread->initPrio;
+
+    const MDS_Mutex_t *iter = NULL;
+    MDS_DLIST_FOREACH_NEXT (iter, nodeHold, &(thread->listHold)) {
+        if (iter->priority.priority < priority.priority) {
+            priority = iter->priority;
+        }
+        if (iter->ceiling.priority < priority.priority) {
+            priority = iter->ceiling;
+        }
+    }
+
+    return (priority);
+}
+
+static bool MUTEX_PropagatePriority(MDS_Thread_t *thread)
+{
+    bool changed = false;
+
+    // walk along the blocking chain: owner -> mutex it waits -> that mutex owner -> ...
+    while (thread != NULL) {
+        MDS_ThreadPriority_t priority = MUTEX_InheritPriority(thread);
+        if (priority.priority == thread->currPrio.priority) {
+            break;
+        }
+
+        MDS_ThreadSetPriority(thread, priority);
+        changed = true;
+
+        MDS_Mutex_t *mutex = thread->mutexWait;
+        if (mutex == NULL) {
+            break;
+        }
+
+        MDS_Lock_t lock = MDS_CriticalLock(&(mutex->spinlock));
+
+        MDS_KernelWaitQueueReorder(&(mutex->queueWait), thread);
+        MUTEX_UpdatePriority(mutex);
+        thread = mutex->owner;
+
+        MDS_CriticalRestore(&(mutex->spinlock), lock);
+    }
+
+    return (changed);
+}
+
+static void MUTEX_DrainWaiter(MDS_Mutex_t *mutex)
+{
+    MDS_Thread_t *iter = NULL;
+    MDS_DLIST_FOREACH_NEXT (iter, nodeWait.node, &(mutex->queueWait.list)) {
+        iter->mutexWait = NULL;
+    }
+
+    MDS_KernelWaitQueueDrain(&(mutex->queueWait));
+
+    if (mutex->owner != NULL) {
+        MDS_DListRemoveNode(&(mutex->nodeHold));
+        MUTEX_PropagatePriority(mutex->owner);
+        mutex->owner = NULL;
+    }
+}
+
+static void MUTEX_Init(MDS_Mutex_t *mutex, MDS_ThreadPriority_t ceiling)
+{
+    mutex->owner = NULL;
+    mutex->priority = MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
+    mutex->ceiling = ceiling;
+    mutex->value = 1;
+    mutex->nest = 0;
+    MDS_KernelWaitQueueInit(&(mutex->queueWait));
+    MDS_DListInitNode(&(mutex->nodeHold));
+    MDS_SpinLockInit(&(mutex->spinlock));
+}
+
 MDS_Err_t MDS_MutexInit(MDS_Mutex_t *mutex, const char *name)
 {
     MDS_ASSERT(mutex != NULL);
 
     MDS_Err_t err = MDS_ObjectInit(&(mutex->object), MDS_OBJECT_TYPE_MUTEX, name);
     if (err == MDS_EOK) {
-        mutex->owner = NULL;
-        mutex->priority = MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
-        mutex->value = 1;
-        mutex->nest = 0;
-        MDS_KernelWaitQueueInit(&(mutex->queueWait));
-        MDS_SpinLockInit(&(mutex->spinlock));
+        MUTEX_Init(mutex, MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX));
+    }
+
+    return (err);
+}
+
+MDS_Err_t MDS_MutexInitCeiling(MDS_Mutex_t *mutex, const char *name, MDS_ThreadPriority_t ceiling)
+{
+    MDS_ASSERT(mutex != NULL);
+    MDS_ASSERT(ceiling.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
+
+    MDS_Err_t err = MDS_ObjectInit(&(mutex->object), MDS_OBJECT_TYPE_MUTEX, name);
+    if (err == MDS_EOK) {
+        MUTEX_Init(mutex, ceiling);
     }
 
     return (err);
@@ -40,7 +133,7 @@ MDS_Err_t MDS_MutexDeInit(MDS_Mutex_t *mutex)
 
     MDS_Lock_t lock = MDS_CriticalLock(&(mutex->spinlock));
 
-    MDS_KernelWaitQueueDrain(&(mutex->queueWait));
+    MUTEX_DrainWaiter(mutex);
     MDS_Err_t err = MDS_ObjectDeInit(&(mutex)->object);
 
     MDS_CriticalRestore((err != MDS_EOK) ? (&(mutex->spinlock)) : (NULL), lock);
@@ -53,12 +146,20 @@ MDS_Mutex_t *MDS_MutexCreate(const char *name)
     MDS_Mutex_t *mutex = (MDS_Mutex_t *)MDS_ObjectCreate(sizeof(MDS_Mutex_t),
                                                          MDS_OBJECT_TYPE_MUTEX, name);
     if (mutex != NULL) {
-        mutex->owner = NULL;
-        mutex->priority = MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
-        mutex->value = 1;
-        mutex->nest = 0;
-        MDS_KernelWaitQueueInit(&(mutex->queueWait));
-        MDS_SpinLockInit(&(mutex->spinlock));
+        MUTEX_Init(mutex, MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX));
+    }
+
+    return (mutex);
+}
+
+MDS_Mutex_t *MDS_MutexCreateCeiling(const char *name, MDS_ThreadPriority_t ceiling)
+{
+    MDS_ASSERT(ceiling.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
+
+    MDS_Mutex_t *mutex = (MDS_Mutex_t *)MDS_ObjectCreate(sizeof(MDS_Mutex_t),
+                                                         MDS_OBJECT_TYPE_MUTEX, name);
+    if (mutex != NULL) {
+        MUTEX_Init(mutex, ceiling);
     }
 
     return (mutex);
@@ -71,7 +172,7 @@ MDS_Err_t MDS_MutexDestroy(MDS_Mutex_t *mutex)
 
     MDS_Lock_t lock = MDS_CriticalLock(&(mutex->spinlock));
 
-    MDS_KernelWaitQueueDrain(&(mutex->queueWait));
+    MUTEX_DrainWaiter(mutex);
     MDS_Err_t err = MDS_ObjectDestroy(&(mutex->object));
 
     MDS_CriticalRestore((err != MDS_EOK) ? (&(mutex->spinlock)) : (NULL), lock);
@@ -88,14 +189,14 @@ MDS_Err_t MDS_MutexAcquire(MDS_Mutex_t *mutex, MDS_Timeout_t timeout)
     bool reSchedule = false;
     MDS_Thread_t *thread = MDS_KernelCurrentThread();
 
-    MDS_LOG_D("[mutex] thread(%p) entry:%p acquire mutex(%p) value:%u nest:%u onwer:%p", thread,
-              thread->entry, mutex, mutex->value, mutex->nest, mutex->owner);
-
     if (thread == NULL) {
         MDS_LOG_W("[mutex] thread is null try to acquire mutex");
         return (MDS_EFAULT);
     }
 
+    MDS_LOG_D("[mutex] thread(%p) entry:%p acquire mutex(%p) value:%u nest:%u onwer:%p", thread,
+              thread->entry, mutex, mutex->value, mutex->nest, mutex->owner);
+
     MDS_HOOK_CALL(KERNEL, mutex, (mutex, MDS_KERNEL_TRACE_MUTEX_TRY_ACQUIRE, err, timeout));
 
     MDS_Lock_t lock = MDS_CriticalLock(&(mutex->spinlock));
@@ -106,26 +207,31 @@ MDS_Err_t MDS_MutexAcquire(MDS_Mutex_t *mutex, MDS_Timeout_t timeout)
         } else {
             err = MDS_ERANGE;
         }
+    } else if ((mutex->ceiling.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX) &&
+               (thread->initPrio.priority < mutex->ceiling.priority)) {
+        // thread base priority above the ceiling breaks the protocol bound
+        err = thread->err = MDS_EACCES;
     } else if (mutex->value > 0) {
         mutex->value -= 1;
         mutex->owner = thread;
-        mutex->priority = thread->currPrio;
-        if (mutex->nest < (__typeof__(mutex->nest))(-1)) {
-            mutex->nest += 1;
-        } else {
-            err = MDS_ERANGE;
+        mutex->nest = 1;
+        MDS_DListInsertNodePrev(&(thread->listHold), &(mutex->nodeHold));
+        if ((mutex->ceiling.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX) &&
+            (mutex->ceiling.priority < thread->currPrio.priority)) {
+            // immediate ceiling, no other thread sharing the mutex can preempt the owner
+            MUTEX_PropagatePriority(thread);
         }
     } else if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
         err = thread->err = MDS_ETIMEOUT;
-    } else if (timeout.ticks < MDS_CLOCK_TICK_TIMER_MAX) {
-        MDS_ThreadPriority_t tempPrio = mutex->owner->currPrio;
-        if (thread->currPrio.priority < mutex->owner->currPrio.priority) {
-            MDS_ThreadSetPriority(mutex->owner, thread->currPrio);
-        }
+    } else if (MDS_KernelWaitQueueTimeout(timeout)) {
+        thread->err = MDS_EOK;
         err = MDS_KernelWaitQueueSuspend(&(mutex->queueWait), thread, timeout, true);
-        if (err != MDS_EOK) {
-            MDS_ThreadSetPriority(mutex->owner, tempPrio);
-        } else {
+        if (err == MDS_EOK) {
+            thread->mutexWait = mutex;
+            if (thread->currPrio.priority < mutex->priority.priority) {
+                mutex->priority = thread->currPrio;
+                MUTEX_PropagatePriority(mutex->owner);
+            }
             reSchedule = true;
         }
     } else {
@@ -139,6 +245,17 @@ MDS_Err_t MDS_MutexAcquire(MDS_Mutex_t *mutex, MDS_Timeout_t timeout)
     if (reSchedule) {
         MDS_KernelSchedulerCheck();
         err = thread->err;
+
+        if (thread->mutexWait == mutex) {
+            // woken up without ownership (timeout), withdraw the boost given to owner
+            lock = MDS_CriticalLock(&(mutex->spinlock));
+
+            thread->mutexWait = NULL;
+            MUTEX_UpdatePriority(mutex);
+            MUTEX_PropagatePriority(mutex->owner);
+
+            MDS_CriticalRestore(&(mutex->spinlock), lock);
+        }
     }
 
     return (err);
@@ -175,12 +292,10 @@ MDS_Err_t MDS_MutexRelease(MDS_Mutex_t *mutex)
             break;
         }
 
-        if (mutex->priority.priority != mutex->owner->currPrio.priority) {
-            MDS_ThreadSetPriority(mutex->owner, mutex->priority);
-        }
+        MDS_DListRemoveNode(&(mutex->nodeHold));
 
-        thread = MDS_KernelWaitQueueResume(&(mutex->queueWait));
-        if (thread == NULL) {
+        MDS_Thread_t *waiter = MDS_KernelWaitQueueResume(&(mutex->queueWait));
+        if (waiter == NULL) {
             mutex->owner = NULL;
             mutex->priority = MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
             if (mutex->value < (__typeof__(mutex->value))(-1)) {
@@ -188,11 +303,17 @@ MDS_Err_t MDS_MutexRelease(MDS_Mutex_t *mutex)
             }
         } else {
             reSchedule = true;
-            mutex->owner = thread;
-            mutex->priority = mutex->owner->currPrio;
-            if (mutex->nest < (__typeof__(mutex->nest))(-1)) {
-                mutex->nest += 1;
-            }
+            waiter->mutexWait = NULL;
+            mutex->owner = waiter;
+            mutex->nest = 1;
+            MDS_DListInsertNodePrev(&(waiter->listHold), &(mutex->nodeHold));
+            MUTEX_UpdatePriority(mutex);
+            MUTEX_PropagatePriority(waiter);
+        }
+
+        // drop to the highest priority still inherited from other held mutexes
+        if (MUTEX_PropagatePriority(thread)) {
+            reSchedule = true;
         }
     } while (0);
     MDS_CriticalRestore(&(mutex->spinlock), lock);
@@ -204,6 +325,37 @@ MDS_Err_t MDS_MutexRelease(MDS_Mutex_t *mutex)
     return (err);
 }
 
+bool MDS_MutexMorphWaiter(MDS_Mutex_t *mutex, MDS_Thread_t *thread)
+{
+    MDS_ASSERT(mutex != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(mutex->object)) == MDS_OBJECT_TYPE_MUTEX);
+
+    bool acquired = false;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(mutex->spinlock));
+
+    // thread is still suspended, take the mutex for it or move it onto the wait queue
+    if (mutex->value > 0) {
+        mutex->value -= 1;
+        mutex->owner = thread;
+        mutex->nest = 1;
+        MDS_DListInsertNodePrev(&(thread->listHold), &(mutex->nodeHold));
+        MUTEX_PropagatePriority(thread);
+        acquired = true;
+    } else {
+        MDS_KernelWaitQueueReorder(&(mutex->queueWait), thread);
+        thread->mutexWait = mutex;
+        if (thread->currPrio.priority < mutex->priority.priority) {
+            mutex->priority = thread->currPrio;
+            MUTEX_PropagatePriority(mutex->owner);
+        }
+    }
+
+    MDS_CriticalRestore(&(mutex->spinlock), lock);
+
+    return (acquired);
+}
+
 MDS_Thread_t *MDS_MutexGetOwner(const MDS_Mutex_t *mutex)
 {
     MDS_ASSERT(mutex != NULL);
@@ -15,147 +15,296 @@
 /* Define ------------------------------------------------------------------ */
 MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 
+#define RWLOCK_STATE_WRITER  0x01
+#define RWLOCK_STATE_WAIT_WR 0x02
+#define RWLOCK_STATE_WAIT_RD 0x04
+#define RWLOCK_STATE_WAITING (RWLOCK_STATE_WAIT_WR | RWLOCK_STATE_WAIT_RD)
+#define RWLOCK_STATE_READER  0x08
+
 /* Function ---------------------------------------------------------------- */
-MDS_Err_t MDS_RwLockInit(MDS_RwLock_t *rwlock, const char *name)
+static inline bool RWLOCK_CanRead(const MDS_RwLock_t *rwlock, intptr_t state)
 {
-    MDS_ASSERT(rwlock != NULL);
+    if (rwlock->prefer == MDS_RWLOCK_PREFER_READER) {
+        return ((state & RWLOCK_STATE_WRITER) == 0);
+    } else {
+        return ((state & (RWLOCK_STATE_WRITER | RWLOCK_STATE_WAIT_WR)) == 0);
+    }
+}
 
-    MDS_Err_t err = MDS_MutexInit(&(rwlock->mutex), name);
-    if (err == MDS_EOK) {
-        MDS_ConditionInit(&(rwlock->condRd), name);
-        MDS_ConditionInit(&(rwlock->condWr), name);
-        rwlock->readers = 0;
+static inline bool RWLOCK_CanWrite(intptr_t state)
+{
+    return ((state & ~RWLOCK_STATE_WAITING) == 0);
+}
+
+static size_t RWLOCK_WaitCount(MDS_WaitQueue_t *queueWait)
+{
+    size_t count = 0;
+
+    MDS_Thread_t *iter = NULL;
+    MDS_DLIST_FOREACH_NEXT (iter, nodeWait.node, &(queueWait->list)) {
+        count += 1;
     }
 
-    return (err);
+    return (count);
 }
 
-MDS_Err_t MDS_RwLockDeInit(MDS_RwLock_t *rwlock)
+static bool RWLOCK_Dispatch(MDS_RwLock_t *rwlock)
 {
-    MDS_ASSERT(rwlock != NULL);
+    // hand the lock over to waiters directly, so woken threads need not to compete again
+    size_t readers = RWLOCK_WaitCount(&(rwlock->queueRd));
+    size_t writers = RWLOCK_WaitCount(&(rwlock->queueWr));
+    intptr_t state = MDS_AtomicLoad(&(rwlock->state));
+    intptr_t grant, flags;
 
-    MDS_Err_t err = MDS_MutexAcquire(&(rwlock->mutex), MDS_TIMEOUT_NO_WAIT);
-    if (err != MDS_EOK) {
-        return (err);
+    do {
+        grant = 0;
+        if ((writers != 0) && RWLOCK_CanWrite(state) &&
+            ((rwlock->prefer == MDS_RWLOCK_PREFER_WRITER) || (readers == 0))) {
+            grant = RWLOCK_STATE_WRITER;
+        } else if ((readers != 0) && ((state & RWLOCK_STATE_WRITER) == 0) &&
+                   ((rwlock->prefer == MDS_RWLOCK_PREFER_READER) || (writers == 0))) {
+            grant = (intptr_t)(readers) * RWLOCK_STATE_READER;
+        }
+
+        flags = 0;
+        if (writers > ((grant == RWLOCK_STATE_WRITER) ? (1U) : (0U))) {
+            flags |= RWLOCK_STATE_WAIT_WR;
+        }
+        if ((readers != 0) && ((grant == 0) || (grant == RWLOCK_STATE_WRITER))) {
+            flags |= RWLOCK_STATE_WAIT_RD;
+        }
+    } while (!MDS_AtomicCompareExchange(&(rwlock->state), &state,
+                                        ((state & ~RWLOCK_STATE_WAITING) + grant) | flags));
+
+    if (grant == RWLOCK_STATE_WRITER) {
+        MDS_KernelWaitQueueResume(&(rwlock->queueWr));
+    } else if (grant != 0) {
+        while (MDS_KernelWaitQueueResume(&(rwlock->queueRd)) != NULL) {
+        }
     }
 
-    if ((rwlock->readers != 0) || (MDS_KernelWaitQueuePeek(&(rwlock->condWr.queueWait)) != NULL) ||
-        (MDS_KernelWaitQueuePeek(&(rwlock->condRd.queueWait)) != NULL)) {
-        err = MDS_EBUSY;
-    } else {
-        err = MDS_SemaphoreAcquire(&(rwlock->condRd), MDS_TIMEOUT_NO_WAIT);
-        if (err == MDS_EOK) {
-            err = MDS_SemaphoreAcquire(&(rwlock->condWr), MDS_TIMEOUT_NO_WAIT);
-            if (err == MDS_EOK) {
-                MDS_SemaphoreRelease(&(rwlock->condRd));
-                MDS_SemaphoreRelease(&(rwlock->condWr));
-
-                MDS_SemaphoreDeInit(&(rwlock->condRd));
-                MDS_SemaphoreDeInit(&(rwlock->condWr));
-            } else {
-                MDS_SemaphoreRelease(&(rwlock->condRd));
-                err = MDS_EBUSY;
+    return (grant != 0);
+}
+
+static MDS_Err_t RWLOCK_Suspend(MDS_RwLock_t *rwlock, MDS_Thread_t *thread, MDS_Timeout_t timeout,
+                                bool isWriter)
+{
+    MDS_Err_t err = MDS_EOK;
+    bool reSchedule = false;
+    intptr_t flag = (isWriter) ? (RWLOCK_STATE_WAIT_WR) : (RWLOCK_STATE_WAIT_RD);
+    MDS_WaitQueue_t *queueWait = (isWriter) ? (&(rwlock->queueWr)) : (&(rwlock->queueRd));
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(rwlock->spinlock));
+
+    intptr_t state = MDS_AtomicLoad(&(rwlock->state));
+    MDS_LOOP {
+        bool acquire = (isWriter) ? (RWLOCK_CanWrite(state)) : (RWLOCK_CanRead(rwlock, state));
+        if (acquire) {
+            intptr_t grant = (isWriter) ? (RWLOCK_STATE_WRITER) : (RWLOCK_STATE_READER);
+            if (MDS_AtomicCompareExchange(&(rwlock->state), &state, state + grant)) {
+                break;
             }
-        } else {
-            err = MDS_EBUSY;
+        } else if (MDS_AtomicCompareExchange(&(rwlock->state), &state, state | flag)) {
+            // waiter flag forces the owner release into the slow path
+            thread->err = MDS_EOK;
+            err = MDS_KernelWaitQueueSuspend(queueWait, thread, timeout, true);
+            reSchedule = (err == MDS_EOK);
+            break;
         }
     }
-    MDS_MutexRelease(&(rwlock->mutex));
 
-    if (err == MDS_EOK) {
-        MDS_MutexDeInit(&(rwlock->mutex));
+    MDS_CriticalRestore(&(rwlock->spinlock), lock);
+
+    if (!reSchedule) {
+        return (err);
+    }
+
+    MDS_KernelSchedulerCheck();
+    err = thread->err;
+    if (err != MDS_EOK) {
+        lock = MDS_CriticalLock(&(rwlock->spinlock));
+
+        reSchedule = RWLOCK_Dispatch(rwlock);
+
+        MDS_CriticalRestore(&(rwlock->spinlock), lock);
+
+        if (reSchedule) {
+            MDS_KernelSchedulerCheck();
+        }
     }
 
     return (err);
 }
 
-MDS_Err_t MDS_RwLockAcquireRead(MDS_RwLock_t *rwlock, MDS_Timeout_t timeout)
+static void RWLOCK_Init(MDS_RwLock_t *rwlock, MDS_RwLockPrefer_t prefer)
+{
+    MDS_AtomicStore(&(rwlock->state), 0);
+    rwlock->prefer = prefer;
+    MDS_KernelWaitQueueInit(&(rwlock->queueRd));
+    MDS_KernelWaitQueueInit(&(rwlock->queueWr));
+    MDS_SpinLockInit(&(rwlock->spinlock));
+}
+
+MDS_Err_t MDS_RwLockInit(MDS_RwLock_t *rwlock, const char *name)
+{
+    return (MDS_RwLockInitPrefer(rwlock, name, MDS_RWLOCK_PREFER_WRITER));
+}
+
+MDS_Err_t MDS_RwLockInitPrefer(MDS_RwLock_t *rwlock, const char *name, MDS_RwLockPrefer_t prefer)
 {
     MDS_ASSERT(rwlock != NULL);
 
-    MDS_Tick_t startTick = MDS_ClockGetTickCount();
-    MDS_Err_t err = MDS_MutexAcquire(&(rwlock->mutex), timeout);
-    if (err != MDS_EOK) {
-        return (err);
+    MDS_Err_t err = MDS_ObjectInit(&(rwlock->object), MDS_OBJECT_TYPE_RWLOCK, name);
+    if (err == MDS_EOK) {
+        RWLOCK_Init(rwlock, prefer);
     }
 
-    while ((rwlock->readers < 0) ||
-           (MDS_KernelWaitQueuePeek(&(rwlock->condWr.queueWait)) != NULL)) {
-        if (timeout.ticks != MDS_CLOCK_TICK_FOREVER) {
-            MDS_Tick_t elapsedTick = MDS_ClockGetTickCount() - startTick;
-            timeout.ticks = (elapsedTick <= timeout.ticks) ? (timeout.ticks - elapsedTick)
-                                                           : (MDS_CLOCK_TICK_NO_WAIT);
-        }
-        err = MDS_ConditionWait(&(rwlock->condRd), &(rwlock->mutex), timeout);
+    return (err);
+}
+
+MDS_Err_t MDS_RwLockDeInit(MDS_RwLock_t *rwlock)
+{
+    MDS_ASSERT(rwlock != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(rwlock->object)) == MDS_OBJECT_TYPE_RWLOCK);
+
+    MDS_Err_t err = MDS_EBUSY;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(rwlock->spinlock));
+
+    intptr_t state = 0;
+    if (MDS_AtomicCompareExchange(&(rwlock->state), &state, RWLOCK_STATE_WRITER)) {
+        err = MDS_ObjectDeInit(&(rwlock->object));
         if (err != MDS_EOK) {
-            break;
+            MDS_AtomicStore(&(rwlock->state), 0);
         }
     }
 
-    if (err == MDS_EOK) {
-        rwlock->readers += 1;
+    MDS_CriticalRestore((err != MDS_EOK) ? (&(rwlock->spinlock)) : (NULL), lock);
+
+    return (err);
+}
+
+MDS_RwLock_t *MDS_RwLockCreate(const char *name)
+{
+    return (MDS_RwLockCreatePrefer(name, MDS_RWLOCK_PREFER_WRITER));
+}
+
+MDS_RwLock_t *MDS_RwLockCreatePrefer(const char *name, MDS_RwLockPrefer_t prefer)
+{
+    MDS_RwLock_t *rwlock = (MDS_RwLock_t *)MDS_ObjectCreate(sizeof(MDS_RwLock_t),
+                                                            MDS_OBJECT_TYPE_RWLOCK, name);
+    if (rwlock != NULL) {
+        RWLOCK_Init(rwlock, prefer);
+    }
+
+    return (rwlock);
+}
+
+MDS_Err_t MDS_RwLockDestroy(MDS_RwLock_t *rwlock)
+{
+    MDS_ASSERT(rwlock != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(rwlock->object)) == MDS_OBJECT_TYPE_RWLOCK);
+
+    MDS_Err_t err = MDS_EBUSY;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(rwlock->spinlock));
+
+    intptr_t state = 0;
+    if (MDS_AtomicCompareExchange(&(rwlock->state), &state, RWLOCK_STATE_WRITER)) {
+        err = MDS_ObjectDestroy(&(rwlock->object));
+        if (err != MDS_EOK) {
+            MDS_AtomicStore(&(rwlock->state), 0);
+        }
     }
 
-    MDS_MutexRelease(&(rwlock->mutex));
+    MDS_CriticalRestore((err != MDS_EOK) ? (&(rwlock->spinlock)) : (NULL), lock);
 
     return (err);
 }
 
-MDS_Err_t MDS_RwLockAcquireWrite(MDS_RwLock_t *rwlock, MDS_Timeout_t timeout)
+MDS_Err_t MDS_RwLockAcquireRead(MDS_RwLock_t *rwlock, MDS_Timeout_t timeout)
 {
     MDS_ASSERT(rwlock != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(rwlock->object)) == MDS_OBJECT_TYPE_RWLOCK);
 
-    MDS_Tick_t startTick = MDS_ClockGetTickCount();
-    MDS_Err_t err = MDS_MutexAcquire(&(rwlock->mutex), timeout);
-    if (err != MDS_EOK) {
-        return (err);
+    intptr_t state = MDS_AtomicLoad(&(rwlock->state));
+    while (RWLOCK_CanRead(rwlock, state)) {
+        if (MDS_AtomicCompareExchange(&(rwlock->state), &state, state + RWLOCK_STATE_READER)) {
+            return (MDS_EOK);
+        }
     }
 
-    while (rwlock->readers != 0) {
-        if (timeout.ticks != MDS_CLOCK_TICK_FOREVER) {
-            MDS_Tick_t elapsedTick = MDS_ClockGetTickCount() - startTick;
-            timeout.ticks = (elapsedTick <= timeout.ticks) ? (timeout.ticks - elapsedTick)
-                                                           : (MDS_CLOCK_TICK_NO_WAIT);
-        }
-        err = MDS_ConditionWait(&(rwlock->condWr), &(rwlock->mutex), timeout);
-        if (err != MDS_EOK) {
-            break;
-        }
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+        return (MDS_ETIMEOUT);
+    } else if (!MDS_KernelWaitQueueTimeout(timeout) || (thread == NULL)) {
+        return (MDS_EINVAL);
     }
 
-    if (err == MDS_EOK) {
-        rwlock->readers -= 1;
+    return (RWLOCK_Suspend(rwlock, thread, timeout, false));
+}
+
+MDS_Err_t MDS_RwLockAcquireWrite(MDS_RwLock_t *rwlock, MDS_Timeout_t timeout)
+{
+    MDS_ASSERT(rwlock != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(rwlock->object)) == MDS_OBJECT_TYPE_RWLOCK);
+
+    intptr_t state = 0;
+    if (MDS_AtomicCompareExchange(&(rwlock->state), &state, RWLOCK_STATE_WRITER)) {
+        return (MDS_EOK);
     }
 
-    MDS_MutexRelease(&(rwlock->mutex));
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+        return (MDS_ETIMEOUT);
+    } else if (!MDS_KernelWaitQueueTimeout(timeout) || (thread == NULL)) {
+        return (MDS_EINVAL);
+    }
 
-    return (err);
+    return (RWLOCK_Suspend(rwlock, thread, timeout, true));
 }
 
 MDS_Err_t MDS_RwLockRelease(MDS_RwLock_t *rwlock)
 {
     MDS_ASSERT(rwlock != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(rwlock->object)) == MDS_OBJECT_TYPE_RWLOCK);
 
-    MDS_Err_t err = MDS_MutexAcquire(&(rwlock->mutex), MDS_TIMEOUT_FOREVER);
-    if (err != MDS_EOK) {
-        return (err);
+    intptr_t state = MDS_AtomicLoad(&(rwlock->state));
+    while ((state & RWLOCK_STATE_WAITING) == 0) {
+        intptr_t release = ((state & RWLOCK_STATE_WRITER) != 0) ? (RWLOCK_STATE_WRITER)
+                                                                 : (RWLOCK_STATE_READER);
+        if (state < release) {
+            return (MDS_EACCES);
+        }
+        if (MDS_AtomicCompareExchange(&(rwlock->state), &state, state - release)) {
+            return (MDS_EOK);
+        }
     }
 
-    if (rwlock->readers > 0) {
-        rwlock->readers -= 1;
-    } else if (rwlock->readers == -1) {
-        rwlock->readers = 0;
-    }
+    MDS_Err_t err = MDS_EOK;
+    bool reSchedule = false;
 
-    if (MDS_KernelWaitQueuePeek(&(rwlock->condWr.queueWait)) != NULL) {
-        if (rwlock->readers == 0) {
-            err = MDS_ConditionSignal(&(rwlock->condWr));
+    MDS_Lock_t lock = MDS_CriticalLock(&(rwlock->spinlock));
+
+    state = MDS_AtomicLoad(&(rwlock->state));
+    MDS_LOOP {
+        intptr_t release = ((state & RWLOCK_STATE_WRITER) != 0) ? (RWLOCK_STATE_WRITER)
+                                                                 : (RWLOCK_STATE_READER);
+        if ((state & ~RWLOCK_STATE_WAITING) < release) {
+            err = MDS_EACCES;
+            break;
+        }
+        if (MDS_AtomicCompareExchange(&(rwlock->state), &state, state - release)) {
+            reSchedule = RWLOCK_Dispatch(rwlock);
+            break;
         }
-    } else if (MDS_KernelWaitQueuePeek(&(rwlock->condRd.queueWait)) != NULL) {
-        err = MDS_ConditionBroadCast(&(rwlock->condRd));
     }
 
-    MDS_MutexRelease(&(rwlock->mutex));
+    MDS_CriticalRestore(&(rwlock->spinlock), lock);
+
+    if (reSchedule) {
+        MDS_KernelSchedulerCheck();
+    }
 
     return (err);
 }
@@ -22,8 +22,9 @@ MDS_Err_t MDS_SemaphoreInit(MDS_Semaphore_t *semaphore, const char *name, size_t
 
     MDS_Err_t err = MDS_ObjectInit(&(semaphore->object), MDS_OBJECT_TYPE_SEMAPHORE, name);
     if (err == MDS_EOK) {
-        semaphore->value = init;
+        MDS_AtomicStore(&(semaphore->value), (intptr_t)(init));
         semaphore->max = max;
+        semaphore->handoff = 0;
         MDS_KernelWaitQueueInit(&(semaphore->queueWait));
         MDS_SpinLockInit(&(semaphore->spinlock));
     }
@@ -52,8 +53,9 @@ MDS_Semaphore_t *MDS_SemaphoreCreate(const char *name, size_t init, size_t max)
                                                                      MDS_OBJECT_TYPE_SEMAPHORE,
                                                                      name);
     if (semaphore != NULL) {
-        semaphore->value = init;
+        MDS_AtomicStore(&(semaphore->value), (intptr_t)(init));
         semaphore->max = max;
+        semaphore->handoff = 0;
         MDS_KernelWaitQueueInit(&(semaphore->queueWait));
         MDS_SpinLockInit(&(semaphore->spinlock));
     }
@@ -84,26 +86,51 @@ MDS_Err_t MDS_SemaphoreAcquire(MDS_Semaphore_t *semaphore, MDS_Timeout_t timeout
     MDS_Err_t err = MDS_EOK;
     bool reSchedule = false;
     MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    intptr_t value = MDS_AtomicLoad(&(semaphore->value));
 
-    MDS_LOG_D("[semaphore] thread(%p) acquire semephore(%p) err:%d, value:%zu", thread, semaphore,
-              err, semaphore->value);
+    MDS_LOG_D("[semaphore] thread(%p) acquire semephore(%p) err:%d, value:%d", thread, semaphore,
+              err, (int)value);
 
     MDS_HOOK_CALL(KERNEL, semaphore,
                   (semaphore, MDS_KERNEL_TRACE_SEMAPHORE_TRY_ACQUIRE, err, timeout));
 
+    // uncontended, take the count without entering critical section
+    while (value > 0) {
+        if (MDS_AtomicCompareExchange(&(semaphore->value), &value, value - 1)) {
+            MDS_HOOK_CALL(KERNEL, semaphore,
+                          (semaphore, MDS_KERNEL_TRACE_SEMAPHORE_HAS_ACQUIRE, err, timeout));
+            return (MDS_EOK);
+        }
+    }
+
+    if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+        if (thread != NULL) {
+            thread->err = MDS_ETIMEOUT;
+        }
+        return (MDS_ETIMEOUT);
+    } else if (!MDS_KernelWaitQueueTimeout(timeout) || (thread == NULL)) {
+        return (MDS_EINVAL);
+    }
+
     MDS_Lock_t lock = MDS_CriticalLock(&(semaphore->spinlock));
 
-    if (semaphore->value > 0) {
-        semaphore->value -= 1;
-    } else if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
-        err = thread->err = MDS_ETIMEOUT;
-    } else if ((timeout.ticks < MDS_CLOCK_TICK_TIMER_MAX) && (thread != NULL)) {
-        err = MDS_KernelWaitQueueSuspend(&(semaphore->queueWait), thread, timeout, true);
-        if (err == MDS_EOK) {
-            reSchedule = true;
+    value = MDS_AtomicLoad(&(semaphore->value));
+    MDS_LOOP {
+        if (MDS_AtomicCompareExchange(&(semaphore->value), &value, value - 1)) {
+            if (value > 0) {
+                break;
+            }
+
+            // count goes negative, release will go through slow path and resume waiter
+            thread->err = MDS_EOK;
+            err = MDS_KernelWaitQueueSuspend(&(semaphore->queueWait), thread, timeout, true);
+            if (err == MDS_EOK) {
+                reSchedule = true;
+            } else {
+                MDS_AtomicFetchAdd(&(semaphore->value), 1);
+            }
+            break;
         }
-    } else {
-        err = MDS_EINVAL;
     }
 
     MDS_CriticalRestore(&(semaphore->spinlock), lock);
@@ -114,6 +141,19 @@ MDS_Err_t MDS_SemaphoreAcquire(MDS_Semaphore_t *semaphore, MDS_Timeout_t timeout
     if (reSchedule) {
         MDS_KernelSchedulerCheck();
         err = thread->err;
+        if ((err != MDS_EOK) && (err != MDS_ENOENT)) {
+            lock = MDS_CriticalLock(&(semaphore->spinlock));
+            if (semaphore->handoff > 0) {
+                // a release found no waiter queued for this deficit, the count is ours
+                semaphore->handoff -= 1;
+                thread->err = MDS_EOK;
+                err = MDS_EOK;
+            } else {
+                // leave without a count, withdraw from the waiters
+                MDS_AtomicFetchAdd(&(semaphore->value), 1);
+            }
+            MDS_CriticalRestore(&(semaphore->spinlock), lock);
+        }
     }
 
     return (err);
@@ -126,23 +166,44 @@ MDS_Err_t MDS_SemaphoreRelease(MDS_Semaphore_t *semaphore)
 
     MDS_Err_t err = MDS_EOK;
     bool reSchedule = false;
+    intptr_t value = MDS_AtomicLoad(&(semaphore->value));
 
-    MDS_LOG_D("[semephore] release semephore(%p) value:%zu", semaphore, semaphore->value);
+    MDS_LOG_D("[semephore] release semephore(%p) value:%d", semaphore, (int)value);
 
-    MDS_Lock_t lock = MDS_CriticalLock(&(semaphore->spinlock));
-
-    MDS_Thread_t *thread = MDS_KernelWaitQueueResume(&(semaphore->queueWait));
-    if (thread == NULL) {
-        if (semaphore->value < semaphore->max) {
-            semaphore->value += 1;
-        } else {
+    // no waiters, give the count back without entering critical section
+    while (value >= 0) {
+        if ((size_t)(value) >= semaphore->max) {
             err = MDS_ERANGE;
+            break;
+        }
+        if (MDS_AtomicCompareExchange(&(semaphore->value), &value, value + 1)) {
+            break;
         }
-    } else {
-        reSchedule = true;
     }
 
-    MDS_CriticalRestore(&(semaphore->spinlock), lock);
+    if (value < 0) {
+        MDS_Lock_t lock = MDS_CriticalLock(&(semaphore->spinlock));
+
+        value = MDS_AtomicLoad(&(semaphore->value));
+        MDS_LOOP {
+            if ((value >= 0) && ((size_t)(value) >= semaphore->max)) {
+                err = MDS_ERANGE;
+                break;
+            }
+            if (MDS_AtomicCompareExchange(&(semaphore->value), &value, value + 1)) {
+                if (value < 0) {
+                    reSchedule = (MDS_KernelWaitQueueResume(&(semaphore->queueWait)) != NULL);
+                    if (!reSchedule) {
+                        // deficit of a waiter dequeued by timeout, it takes the count on return
+                        semaphore->handoff += 1;
+                    }
+                }
+                break;
+            }
+        }
+
+        MDS_CriticalRestore(&(semaphore->spinlock), lock);
+    }
 
     MDS_HOOK_CALL(KERNEL, semaphore,
                   (semaphore, MDS_KERNEL_TRACE_SEMAPHORE_HAS_RELEASE, err, MDS_TIMEOUT_NO_WAIT));
@@ -162,5 +223,7 @@ size_t MDS_SemaphoreGetValue(const MDS_Semaphore_t *semaphore, size_t *max)
         *max = semaphore->max;
     }
 
-    return (semaphore->value);
+    intptr_t value = MDS_AtomicLoad(&(semaphore->value));
+
+    return ((value > 0) ? ((size_t)(value)) : (0U));
 }
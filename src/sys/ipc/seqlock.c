@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) [2022] [pchom]
+ * [MDS] is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ **/
+/* Include ----------------------------------------------------------------- */
+#include "../kernel.h"
+
+/* Function ---------------------------------------------------------------- */
+void MDS_SeqLockInit(MDS_SeqLock_t *seqlock)
+{
+    MDS_ASSERT(seqlock != NULL);
+
+    MDS_AtomicStore(&(seqlock->sequence), 0);
+    MDS_SpinLockInit(&(seqlock->spinlock));
+}
+
+MDS_Lock_t MDS_SeqLockWriteBegin(MDS_SeqLock_t *seqlock)
+{
+    MDS_ASSERT(seqlock != NULL);
+
+    // interrupt locked, readers in isr never spin on a preempted writer
+    MDS_Lock_t lock = MDS_CriticalLock(&(seqlock->spinlock));
+
+    MDS_AtomicStore(&(seqlock->sequence), MDS_AtomicLoad(&(seqlock->sequence)) + 1);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    return (lock);
+}
+
+void MDS_SeqLockWriteEnd(MDS_SeqLock_t *seqlock, MDS_Lock_t lock)
+{
+    MDS_ASSERT(seqlock != NULL);
+    MDS_ASSERT((MDS_AtomicLoad(&(seqlock->sequence)) & 1) != 0);
+
+    MDS_AtomicStore(&(seqlock->sequence), MDS_AtomicLoad(&(seqlock->sequence)) + 1);
+
+    MDS_CriticalRestore(&(seqlock->spinlock), lock);
+}
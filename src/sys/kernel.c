@@ -27,6 +27,14 @@ static struct {
     MDS_SpinLock_t spinlock;
 } g_sysDefunct = {.queue = MDS_DLIST_INIT(g_sysDefunct.queue)};
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+static struct {
+    uint32_t cycleLast;
+    uint64_t cycleTotal;  // cycles since last load sample
+    uint64_t cycleIdle;
+} g_sysCpuStats;
+#endif
+
 // static MDS_KernelCpuInfo_t g_sysCpuInfo[CONFIG_MDS_KERNEL_SMP_CPUS] = {0};
 static MDS_Thread_t *g_sysCurrThread = NULL;
 
@@ -62,6 +70,67 @@ void MDS_KernelSchdulerLockRelease(void)
     }
 }
 
+__attribute__((weak)) uint32_t MDS_CoreCycleCount(void)
+{
+    return ((uint32_t)MDS_ClockGetTickCount());
+}
+
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+static void KERNEL_CpuAccount(MDS_Thread_t *thread)
+{
+    uint32_t cycle = MDS_CoreCycleCount();
+    uint32_t delta = cycle - g_sysCpuStats.cycleLast;
+
+    g_sysCpuStats.cycleLast = cycle;
+    g_sysCpuStats.cycleTotal += delta;
+    if (thread == MDS_KernelIdleThread()) {
+        g_sysCpuStats.cycleIdle += delta;
+    }
+    thread->stats.cycles += delta;
+}
+#endif
+
+void MDS_KernelCpuAccount(void)
+{
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+    // charge on each tick too, so the 32-bit cycle counter never wraps between two samples
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_sysScheduler.spinlock));
+
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    if (thread != NULL) {
+        KERNEL_CpuAccount(thread);
+    }
+
+    MDS_CriticalRestore(&(g_sysScheduler.spinlock), lock);
+#endif
+}
+
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+size_t MDS_KernelGetCpuLoad(void)
+{
+    size_t load = 0;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_sysScheduler.spinlock));
+
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    if (thread != NULL) {
+        KERNEL_CpuAccount(thread);
+    }
+
+    // permille of busy cycles since last call
+    if (g_sysCpuStats.cycleTotal != 0) {
+        load = (size_t)(((g_sysCpuStats.cycleTotal - g_sysCpuStats.cycleIdle) * 1000U) /
+                        g_sysCpuStats.cycleTotal);
+    }
+    g_sysCpuStats.cycleTotal = 0;
+    g_sysCpuStats.cycleIdle = 0;
+
+    MDS_CriticalRestore(&(g_sysScheduler.spinlock), lock);
+
+    return (load);
+}
+#endif
+
 int MDS_KernelSchdulerLockLevel(void)
 {
     return (g_sysScheduler.lockNest);
@@ -78,11 +147,13 @@ void MDS_KernelSchedulerCheck(void)
         }
 
         MDS_Thread_t *toThread = MDS_SchedulerPeekThread();
-        if (MDS_ThreadGetState(currThread) == MDS_THREAD_STATE_RUNNING) {
+        bool isReady = (MDS_ThreadGetState(currThread) == MDS_THREAD_STATE_RUNNING);
+        if (isReady) {
             if (currThread->currPrio.priority < toThread->currPrio.priority) {
                 toThread = currThread;
             } else if ((currThread->currPrio.priority == toThread->currPrio.priority) &&
-                       (!MDS_ThreadIsYield(currThread))) {
+                       (!MDS_ThreadIsYield(currThread)) &&
+                       (!MDS_SchedulerThreadBefore(toThread, currThread))) {
                 toThread = currThread;
             } else {
                 MDS_SchedulerInsertThread(currThread);
@@ -106,6 +177,16 @@ void MDS_KernelSchedulerCheck(void)
 
             MDS_HOOK_CALL(KERNEL, scheduler, (toThread, currThread));
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+            KERNEL_CpuAccount(currThread);
+            if (isReady) {
+                currThread->stats.switchPreempt += 1;
+            } else {
+                currThread->stats.switchVoluntary += 1;
+            }
+            toThread->stats.switchIn += 1;
+#endif
+
             // cpuInfo
             g_sysCurrThread = toThread;
 
@@ -116,35 +197,47 @@ void MDS_KernelSchedulerCheck(void)
     MDS_CriticalRestore(&(g_sysScheduler.spinlock), lock);
 }
 
-MDS_Err_t MDS_KernelWaitQueueSuspend(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread,
-                                     MDS_Timeout_t timeout, bool isPrio)
+static void KERNEL_WaitQueueInsert(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread, bool isPrio)
 {
-    MDS_Err_t err = MDS_ThreadSuspend(thread);
-    if (err != MDS_EOK) {
-        return (err);
-    }
+    MDS_WaitNode_t *nodeWait = &(thread->nodeWait);
 
-    MDS_Thread_t *find = NULL;
+    nodeWait->queue = queueWait;
+    nodeWait->priority = MDS_THREAD_PRIORITY(CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX);
 
-    if (isPrio) {
-        MDS_Thread_t *iter = NULL;
-        MDS_DLIST_FOREACH_NEXT (iter, nodeWait.node, &(queueWait->list)) {
-            if (thread->currPrio.priority < iter->currPrio.priority) {
-                find = iter;
-                break;
-            }
-        }
+    if ((!isPrio) || (thread->currPrio.priority >= CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX)) {
+        MDS_DListInsertNodePrev(&(queueWait->list), &(nodeWait->node));
+        return;
     }
 
-    if (find != NULL) {
-        MDS_DListInsertNodePrev(&(find->nodeWait.node), &(thread->nodeWait.node));
+    // fifo in same priority, insert before the first waiter of next lower priority present
+    uint32_t prio = (uint32_t)(thread->currPrio.priority);
+    uint32_t lowerMask = queueWait->prioMask & ((0xFFFFFFFEUL) << prio);
+    size_t lowerPrio = MDS_SchedulerFFS(lowerMask);
+    if (lowerPrio != 0U) {
+        MDS_DListInsertNodePrev(queueWait->prioHead[lowerPrio - 1], &(nodeWait->node));
     } else {
-        MDS_DListInsertNodePrev(&(queueWait->list), &(thread->nodeWait.node));
+        MDS_DListInsertNodePrev(&(queueWait->list), &(nodeWait->node));
+    }
+
+    if ((queueWait->prioMask & (1UL << prio)) == 0U) {
+        queueWait->prioMask |= (1UL << prio);
+        queueWait->prioHead[prio] = &(nodeWait->node);
     }
+    nodeWait->priority = thread->currPrio;
+}
 
-    err = MDS_SysTimerStart(&(thread->timer), timeout, MDS_TIMEOUT_NO_WAIT);
+MDS_Err_t MDS_KernelWaitQueueSuspend(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread,
+                                     MDS_Timeout_t timeout, bool isPrio)
+{
+    MDS_Err_t err = MDS_ThreadSuspend(thread);
+    if (err != MDS_EOK) {
+        return (err);
+    }
 
-    return (err);
+    KERNEL_WaitQueueInsert(queueWait, thread, isPrio);
+    MDS_ThreadTimeoutStart(thread, timeout);
+
+    return (MDS_EOK);
 }
 
 MDS_Err_t MDS_KernelWaitQueueUntil(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread,
@@ -174,6 +267,37 @@ MDS_Err_t MDS_KernelWaitQueueUntil(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thr
     return (err);
 }
 
+void MDS_KernelWaitQueueRemove(MDS_Thread_t *thread)
+{
+    MDS_WaitNode_t *nodeWait = &(thread->nodeWait);
+    MDS_WaitQueue_t *queueWait = nodeWait->queue;
+
+    if ((queueWait != NULL) &&
+        (nodeWait->priority.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX)) {
+        uint32_t prio = (uint32_t)(nodeWait->priority.priority);
+        if (queueWait->prioHead[prio] == &(nodeWait->node)) {
+            MDS_DListNode_t *next = nodeWait->node.next;
+            if ((next != &(queueWait->list)) &&
+                (CONTAINER_OF(next, MDS_Thread_t, nodeWait.node)->nodeWait.priority.priority ==
+                 nodeWait->priority.priority)) {
+                queueWait->prioHead[prio] = next;
+            } else {
+                queueWait->prioMask &= ~(1UL << prio);
+            }
+        }
+    }
+
+    nodeWait->queue = NULL;
+    MDS_DListRemoveNode(&(nodeWait->node));
+}
+
+void MDS_KernelWaitQueueReorder(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread)
+{
+    // thread priority changed while suspended, move it to the new priority position
+    MDS_KernelWaitQueueRemove(thread);
+    KERNEL_WaitQueueInsert(queueWait, thread, true);
+}
+
 MDS_Thread_t *MDS_KernelWaitQueueResume(MDS_WaitQueue_t *queueWait)
 {
     MDS_Thread_t *thread = MDS_KernelWaitQueuePeek(queueWait);
@@ -190,14 +314,14 @@ MDS_Thread_t *MDS_KernelWaitQueueResume(MDS_WaitQueue_t *queueWait)
 
 void MDS_KernelWaitQueueDrain(MDS_WaitQueue_t *queueWait)
 {
-    do {
+    MDS_LOOP {
         MDS_Thread_t *thread = MDS_KernelWaitQueueResume(queueWait);
         if (thread == NULL) {
             break;
         }
 
         thread->err = MDS_ENOENT;
-    } while (0);
+    }
 }
 
 void MDS_KernelPushDefunct(MDS_Thread_t *thread)
@@ -249,6 +373,11 @@ void MDS_KernelStartup(void)
     MDS_ThreadSetState(toThread, MDS_THREAD_STATE_RUNNING);
     g_sysCurrThread = toThread;
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+    toThread->stats.switchIn += 1;
+    g_sysCpuStats.cycleLast = MDS_CoreCycleCount();
+#endif
+
     MDS_CoreSchedulerStartup(&(toThread->stackPoint));
 }
 
@@ -267,7 +396,13 @@ MDS_Tick_t MDS_KernelGetSleepTick(void)
     // get all cpu is idle
     if (MDS_SchedulerPeekThread() == MDS_KernelIdleThread()) {
         MDS_Tick_t nextTick = MDS_SysTimerNextTick();
+        MDS_Tick_t waitTick = MDS_ThreadTimeoutNextTick();
         MDS_Tick_t currTick = MDS_ClockGetTickCount();
+        if ((waitTick != MDS_CLOCK_TICK_FOREVER) &&
+            ((nextTick == MDS_CLOCK_TICK_FOREVER) ||
+             ((waitTick - currTick) < (nextTick - currTick)))) {
+            nextTick = waitTick;
+        }
         sleepTick = (nextTick > currTick) ? (nextTick - currTick) : (0);
     }
 
@@ -32,12 +32,16 @@ void *MDS_CoreThreadStackInit(void *stackBase, size_t stackSize, void *entry, vo
                               void *exit);
 void MDS_CoreSchedulerStartup(void *toSP);
 void MDS_CoreSchedulerSwitch(void *from, void *to);
+uint32_t MDS_CoreCycleCount(void);
 bool MDS_CoreThreadStackCheck(void *sp);
 
 /* Kernel ------------------------------------------------------------------ */
 static inline void MDS_KernelWaitQueueInit(MDS_WaitQueue_t *queueWait)
 {
     MDS_DListInitNode(&(queueWait->list));
+#if (CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX > 0)
+    queueWait->prioMask = 0U;
+#endif
 }
 
 static inline MDS_Thread_t *MDS_KernelWaitQueuePeek(MDS_WaitQueue_t *queueWait)
@@ -49,25 +53,38 @@ static inline MDS_Thread_t *MDS_KernelWaitQueuePeek(MDS_WaitQueue_t *queueWait)
     }
 }
 
+static inline bool MDS_KernelWaitQueueTimeout(MDS_Timeout_t timeout)
+{
+    return ((timeout.ticks < MDS_CLOCK_TICK_TIMER_MAX) ||
+            (timeout.ticks == MDS_CLOCK_TICK_FOREVER));
+}
+
 MDS_Err_t MDS_KernelWaitQueueSuspend(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread,
                                      MDS_Timeout_t timeout, bool isPrio);
 MDS_Err_t MDS_KernelWaitQueueUntil(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread,
                                    MDS_Timeout_t timeout, bool isPrio, MDS_Lock_t *lock,
                                    MDS_SpinLock_t *spinlock);
+void MDS_KernelWaitQueueRemove(MDS_Thread_t *thread);
+void MDS_KernelWaitQueueReorder(MDS_WaitQueue_t *queueWait, MDS_Thread_t *thread);
 MDS_Thread_t *MDS_KernelWaitQueueResume(MDS_WaitQueue_t *queueWait);
 void MDS_KernelWaitQueueDrain(MDS_WaitQueue_t *queueWait);
 
 void MDS_KernelSchedulerCheck(void);
+void MDS_KernelCpuAccount(void);
 void MDS_KernelPushDefunct(MDS_Thread_t *thread);
 MDS_Thread_t *MDS_KernelPopDefunct(void);
 MDS_Thread_t *MDS_KernelIdleThread(void);
 void MDS_IdleThreadInit(void);
 
 /* Scheduler --------------------------------------------------------------- */
+size_t MDS_SchedulerFFS(uint32_t value);
 void MDS_SchedulerInit(void);
 void MDS_SchedulerInsertThread(MDS_Thread_t *thread);
 void MDS_SchedulerRemoveThread(MDS_Thread_t *thread);
 MDS_Thread_t *MDS_SchedulerPeekThread(void);
+bool MDS_SchedulerThreadBefore(const MDS_Thread_t *thread, const MDS_Thread_t *other);
+MDS_Err_t MDS_SchedulerAdmitDeadline(MDS_Tick_t runtime, MDS_Tick_t deadline,
+                                     MDS_Tick_t oldRuntime, MDS_Tick_t oldDeadline);
 
 /* WorkQueue --------------------------------------------------------------- */
 void MDS_WorkQueueCheck(MDS_WorkQueue_t *workq, MDS_Lock_t *lock);
@@ -78,8 +95,15 @@ void MDS_SysTimerCheck(void);
 MDS_Tick_t MDS_SysTimerNextTick(void);
 MDS_Err_t MDS_SysTimerStart(MDS_Timer_t *timer, MDS_Timeout_t duration, MDS_Timeout_t period);
 
+/* Mutex ------------------------------------------------------------------- */
+bool MDS_MutexMorphWaiter(MDS_Mutex_t *mutex, MDS_Thread_t *thread);
+
 /* Thread ------------------------------------------------------------------ */
 void MDS_ThreadRemainTicks(MDS_Tick_t ticks);
+void MDS_ThreadTimeoutStart(MDS_Thread_t *thread, MDS_Timeout_t timeout);
+void MDS_ThreadTimeoutStop(MDS_Thread_t *thread);
+void MDS_ThreadTimeoutCheck(void);
+MDS_Tick_t MDS_ThreadTimeoutNextTick(void);
 
 static inline void MDS_ThreadSetState(MDS_Thread_t *thread, MDS_ThreadState_t state)
 {
@@ -0,0 +1,258 @@
+/**
+ * Copyright (c) [2022] [pchom]
+ * [MDS] is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ **/
+/* Include ----------------------------------------------------------------- */
+#include "kernel.h"
+
+/* Define ------------------------------------------------------------------ */
+#ifndef CONFIG_MDS_LOG_ASYNC_BUFF_SIZE
+#define CONFIG_MDS_LOG_ASYNC_BUFF_SIZE 1024
+#endif
+
+#ifndef CONFIG_MDS_LOG_ASYNC_LINE_SIZE
+#define CONFIG_MDS_LOG_ASYNC_LINE_SIZE 128
+#endif
+
+#ifndef CONFIG_MDS_LOG_ASYNC_THREAD_PRIORITY
+#define CONFIG_MDS_LOG_ASYNC_THREAD_PRIORITY (CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX - 1)
+#endif
+
+#ifndef CONFIG_MDS_LOG_ASYNC_THREAD_STACKSIZE
+#define CONFIG_MDS_LOG_ASYNC_THREAD_STACKSIZE 512
+#endif
+
+#ifndef CONFIG_MDS_LOG_ASYNC_THREAD_TICKS
+#define CONFIG_MDS_LOG_ASYNC_THREAD_TICKS 16
+#endif
+
+typedef struct LoggerRecord {
+    const MDS_LOG_Module_t *module;
+    uint8_t level;
+    uint16_t len;
+} LoggerRecord_t;
+
+/* Variable ---------------------------------------------------------------- */
+static struct {
+    MDS_LOG_VaPrint_t sink;
+    MDS_Semaphore_t semaphore;
+    MDS_Thread_t thread;
+    size_t head;
+    size_t tail;
+    size_t dropped;   // total
+    size_t overflow;  // since last marker
+    MDS_SpinLock_t spinlock;
+    uint8_t buff[CONFIG_MDS_LOG_ASYNC_BUFF_SIZE];
+} g_logAsync;
+
+static uint8_t g_logAsyncStack[CONFIG_MDS_LOG_ASYNC_THREAD_STACKSIZE];
+
+/* Function ---------------------------------------------------------------- */
+static void LOGGER_CopyIn(size_t pos, const void *data, size_t size)
+{
+    size_t ofs = pos % CONFIG_MDS_LOG_ASYNC_BUFF_SIZE;
+    size_t len = CONFIG_MDS_LOG_ASYNC_BUFF_SIZE - ofs;
+
+    if (len >= size) {
+        MDS_MemBuffCopy(&(g_logAsync.buff[ofs]), size, data, size);
+    } else {
+        MDS_MemBuffCopy(&(g_logAsync.buff[ofs]), len, data, len);
+        MDS_MemBuffCopy(g_logAsync.buff, size - len, (const uint8_t *)data + len, size - len);
+    }
+}
+
+static void LOGGER_CopyOut(size_t pos, void *data, size_t size)
+{
+    size_t ofs = pos % CONFIG_MDS_LOG_ASYNC_BUFF_SIZE;
+    size_t len = CONFIG_MDS_LOG_ASYNC_BUFF_SIZE - ofs;
+
+    if (len >= size) {
+        MDS_MemBuffCopy(data, size, &(g_logAsync.buff[ofs]), size);
+    } else {
+        MDS_MemBuffCopy(data, len, &(g_logAsync.buff[ofs]), len);
+        MDS_MemBuffCopy((uint8_t *)data + len, size - len, g_logAsync.buff, size - len);
+    }
+}
+
+static bool LOGGER_RateAdmit(const MDS_LOG_Module_t *module)
+{
+#if (defined(CONFIG_MDS_LOG_FILTER_ENABLE) && (CONFIG_MDS_LOG_FILTER_ENABLE != 0))
+    if ((module == NULL) || (module->filter == NULL) || (module->filter->rate == 0)) {
+        return (true);
+    }
+
+    MDS_LOG_Filter_t *filter = module->filter;
+    MDS_Tick_t currTick = MDS_ClockGetTickCount();
+    MDS_Tick_t period = CONFIG_MDS_CLOCK_TICK_FREQ_HZ / filter->rate;
+    if (period == 0) {
+        period = 1;
+    }
+
+    // refill one token per period, keep the remainder of elapsed ticks
+    MDS_Tick_t elapsed = currTick - filter->tick;
+    if (elapsed >= period) {
+        size_t refill = elapsed / period;
+        if ((filter->tokens + refill) >= filter->burst) {
+            filter->tokens = filter->burst;
+            filter->tick = currTick;
+        } else {
+            filter->tokens += refill;
+            filter->tick += refill * period;
+        }
+    }
+
+    if (filter->tokens == 0) {
+        filter->dropped += 1;
+        return (false);
+    }
+    filter->tokens -= 1;
+#else
+    UNUSED(module);
+#endif
+
+    return (true);
+}
+
+static void LOGGER_VaPrint(const MDS_LOG_Module_t *module, uint8_t level, size_t va_size,
+                           const char *fmt, va_list va_args)
+{
+    char line[CONFIG_MDS_LOG_ASYNC_LINE_SIZE];
+    bool wakeup = false;
+
+    UNUSED(va_size);
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_logAsync.spinlock));
+    bool admit = LOGGER_RateAdmit(module);
+    if (!admit) {
+        g_logAsync.dropped += 1;
+        g_logAsync.overflow += 1;
+    }
+    MDS_CriticalRestore(&(g_logAsync.spinlock), lock);
+
+    if (!admit) {
+        return;
+    }
+
+    int len = MDS_Vsnprintf(line, sizeof(line), fmt, va_args);
+    if (len < 0) {
+        return;
+    }
+    LoggerRecord_t record = {
+        .module = module,
+        .level = level,
+        .len = (uint16_t)(((size_t)len < sizeof(line)) ? ((size_t)len) : (sizeof(line) - 1U)),
+    };
+
+    lock = MDS_CriticalLock(&(g_logAsync.spinlock));
+
+    if ((sizeof(record) + record.len) >
+        (CONFIG_MDS_LOG_ASYNC_BUFF_SIZE - (g_logAsync.head - g_logAsync.tail))) {
+        g_logAsync.dropped += 1;
+        g_logAsync.overflow += 1;
+    } else {
+        // only the first record wakes the thread, logs from the semaphore itself won't recurse
+        wakeup = (g_logAsync.head == g_logAsync.tail);
+        LOGGER_CopyIn(g_logAsync.head, &record, sizeof(record));
+        LOGGER_CopyIn(g_logAsync.head + sizeof(record), line, record.len);
+        g_logAsync.head += sizeof(record) + record.len;
+    }
+
+    MDS_CriticalRestore(&(g_logAsync.spinlock), lock);
+
+    if (wakeup) {
+        MDS_SemaphoreRelease(&(g_logAsync.semaphore));
+    }
+}
+
+static void LOGGER_SinkPrint(const MDS_LOG_Module_t *module, uint8_t level, size_t va_size,
+                             const char *fmt, ...)
+{
+    va_list va_args;
+
+    va_start(va_args, fmt);
+    g_logAsync.sink(module, level, va_size, fmt, va_args);
+    va_end(va_args);
+}
+
+static void LOGGER_ThreadEntry(MDS_Arg_t *arg)
+{
+    char line[CONFIG_MDS_LOG_ASYNC_LINE_SIZE];
+
+    UNUSED(arg);
+
+    MDS_LOOP {
+        MDS_SemaphoreAcquire(&(g_logAsync.semaphore), MDS_TIMEOUT_FOREVER);
+
+        MDS_LOOP {
+            LoggerRecord_t record;
+            size_t overflow = 0;
+
+            MDS_Lock_t lock = MDS_CriticalLock(&(g_logAsync.spinlock));
+            bool empty = (g_logAsync.head == g_logAsync.tail);
+            if (!empty) {
+                LOGGER_CopyOut(g_logAsync.tail, &record, sizeof(record));
+                LOGGER_CopyOut(g_logAsync.tail + sizeof(record), line, record.len);
+                g_logAsync.tail += sizeof(record) + record.len;
+            } else {
+                overflow = g_logAsync.overflow;
+                g_logAsync.overflow = 0;
+            }
+            MDS_CriticalRestore(&(g_logAsync.spinlock), lock);
+
+            if (empty) {
+                if (overflow != 0) {
+                    LOGGER_SinkPrint(NULL, MDS_LOG_LEVEL_WRN, sizeof(size_t),
+                                     "[log] %zu messages dropped\n", overflow);
+                }
+                break;
+            }
+
+            LOGGER_SinkPrint(record.module, record.level, sizeof(int) + sizeof(void *), "%.*s",
+                             (int)(record.len), line);
+        }
+    }
+}
+
+MDS_Err_t MDS_LOG_AsyncStartup(MDS_LOG_VaPrint_t sink)
+{
+    MDS_ASSERT(sink != NULL);
+
+    if (g_logAsync.sink != NULL) {
+        return (MDS_EBUSY);
+    }
+
+    MDS_SpinLockInit(&(g_logAsync.spinlock));
+    g_logAsync.head = 0;
+    g_logAsync.tail = 0;
+
+    MDS_Err_t err = MDS_SemaphoreInit(&(g_logAsync.semaphore), "log", 0, 1);
+    if (err != MDS_EOK) {
+        return (err);
+    }
+
+    err = MDS_ThreadInit(&(g_logAsync.thread), "log", LOGGER_ThreadEntry, NULL, &g_logAsyncStack,
+                         sizeof(g_logAsyncStack),
+                         MDS_THREAD_PRIORITY(CONFIG_MDS_LOG_ASYNC_THREAD_PRIORITY),
+                         MDS_TIMEOUT_TICKS(CONFIG_MDS_LOG_ASYNC_THREAD_TICKS));
+    if (err != MDS_EOK) {
+        MDS_SemaphoreDeInit(&(g_logAsync.semaphore));
+        return (err);
+    }
+
+    g_logAsync.sink = sink;
+    MDS_LOG_RegisterVaPrint(LOGGER_VaPrint);
+
+    return (MDS_ThreadStartup(&(g_logAsync.thread)));
+}
+
+size_t MDS_LOG_AsyncDropped(void)
+{
+    return (g_logAsync.dropped);
+}
@@ -20,9 +20,18 @@ MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 #error "kernel mlfq scheduler supported max priority 32-bit / 64-bit"
 #endif
 
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+#ifndef CONFIG_MDS_KERNEL_EDF_DENSITY_MAX
+#define CONFIG_MDS_KERNEL_EDF_DENSITY_MAX 1000  // permille of cpu admitted to edf threads
+#endif
+#endif
+
 /* Variable ---------------------------------------------------------------- */
 static volatile uint32_t g_sysThreadPrioMask = 0x00U;
 static MDS_DListNode_t g_sysSchedulerTable[CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX];
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+static size_t g_sysEdfDensity = 0;
+#endif
 
 /* Function ---------------------------------------------------------------- */
 __attribute__((weak)) size_t MDS_SchedulerFFS(uint32_t value)
@@ -69,11 +78,78 @@ void MDS_SchedulerInit(void)
     MDS_SkipListInitNode(g_sysSchedulerTable, ARRAY_SIZE(g_sysSchedulerTable));
 }
 
+bool MDS_SchedulerThreadBefore(const MDS_Thread_t *thread, const MDS_Thread_t *other)
+{
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+    if (thread->edfPeriod == 0) {
+        return (false);
+    } else if (other->edfPeriod == 0) {
+        return (true);
+    } else {
+        return ((thread->edfDeadline - other->edfDeadline) >= MDS_CLOCK_TICK_TIMER_MAX);
+    }
+#else
+    UNUSED(thread);
+    UNUSED(other);
+
+    return (false);
+#endif
+}
+
+MDS_Err_t MDS_SchedulerAdmitDeadline(MDS_Tick_t runtime, MDS_Tick_t deadline,
+                                     MDS_Tick_t oldRuntime, MDS_Tick_t oldDeadline)
+{
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+    MDS_Err_t err = MDS_EOK;
+    size_t density = (deadline > 0) ? ((uint64_t)runtime * 1000U / deadline) : (0);
+    size_t oldDensity = (oldDeadline > 0) ? ((uint64_t)oldRuntime * 1000U / oldDeadline) : (0);
+
+    MDS_Lock_t lock = MDS_CriticalLock(NULL);
+
+    if ((g_sysEdfDensity - oldDensity + density) > CONFIG_MDS_KERNEL_EDF_DENSITY_MAX) {
+        err = MDS_EBUSY;
+    } else {
+        g_sysEdfDensity = g_sysEdfDensity - oldDensity + density;
+    }
+
+    MDS_CriticalRestore(NULL, lock);
+
+    MDS_LOG_D("[scheduler] edf admit density:%zu->%zu total:%zu err:%d", oldDensity, density,
+              g_sysEdfDensity, err);
+
+    return (err);
+#else
+    UNUSED(runtime);
+    UNUSED(deadline);
+    UNUSED(oldRuntime);
+    UNUSED(oldDeadline);
+
+    return (MDS_EPERM);
+#endif
+}
+
 void MDS_SchedulerInsertThread(MDS_Thread_t *thread)
 {
-    MDS_DListRemoveNode(&(thread->nodeWait.node));
+    MDS_KernelWaitQueueRemove(thread);
 
     if (thread->currPrio.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX) {
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+        MDS_DListNode_t *list = &(g_sysSchedulerTable[thread->currPrio.priority]);
+        MDS_DListNode_t *node = list->next;
+
+        // edf threads sorted by deadline ahead of fixed priority threads in same priority
+        if ((thread->edfPeriod != 0) || !MDS_ThreadIsYield(thread)) {
+            while ((node != list) &&
+                   !MDS_SchedulerThreadBefore(thread,
+                                              CONTAINER_OF(node, MDS_Thread_t, nodeWait.node)) &&
+                   (CONTAINER_OF(node, MDS_Thread_t, nodeWait.node)->edfPeriod != 0)) {
+                node = node->next;
+            }
+        } else {
+            node = list;
+        }
+        MDS_DListInsertNodePrev(node, &(thread->nodeWait.node));
+#else
         if (MDS_ThreadIsYield(thread)) {
             MDS_DListInsertNodePrev(&(g_sysSchedulerTable[thread->currPrio.priority]),
                                     &(thread->nodeWait.node));
@@ -81,6 +157,7 @@ void MDS_SchedulerInsertThread(MDS_Thread_t *thread)
             MDS_DListInsertNodeNext(&(g_sysSchedulerTable[thread->currPrio.priority]),
                                     &(thread->nodeWait.node));
         }
+#endif
         g_sysThreadPrioMask |= (1UL << thread->currPrio.priority);
     }
 
@@ -93,7 +170,7 @@ void MDS_SchedulerRemoveThread(MDS_Thread_t *thread)
     MDS_LOG_D("[scheduler] remove thread(%p) entry:%p sp:%p priority:%u", thread, thread->entry,
               thread->stackPoint, thread->currPrio.priority);
 
-    MDS_DListRemoveNode(&(thread->nodeWait.node));
+    MDS_KernelWaitQueueRemove(thread);
 
     if ((thread->currPrio.priority < CONFIG_MDS_KERNEL_THREAD_PRIORITY_MAX) &&
         (MDS_DListIsEmpty(&(g_sysSchedulerTable[thread->currPrio.priority])))) {
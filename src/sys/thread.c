@@ -15,6 +15,12 @@
 /* Define ------------------------------------------------------------------ */
 MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 
+/* Variable ---------------------------------------------------------------- */
+static struct {
+    MDS_DListNode_t list;  // suspended threads sorted by timeout deadline
+    MDS_SpinLock_t spinlock;
+} g_sysThreadTimeout = {.list = MDS_DLIST_INIT(g_sysThreadTimeout.list)};
+
 /* Function ---------------------------------------------------------------- */
 static MDS_Err_t THREAD_Terminate(MDS_Thread_t *thread)
 {
@@ -23,10 +29,17 @@ static MDS_Err_t THREAD_Terminate(MDS_Thread_t *thread)
         return (MDS_EAGAIN);
     }
 
-    MDS_TimerDeInit(&(thread->timer));
+    MDS_ThreadTimeoutStop(thread);
     MDS_SchedulerRemoveThread(thread);
     MDS_KernelPushDefunct(thread);
 
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+    if (thread->edfPeriod != 0) {
+        MDS_SchedulerAdmitDeadline(0, 0, thread->edfRuntime, thread->edfRelative);
+        thread->edfPeriod = 0;
+    }
+#endif
+
     return (MDS_EOK);
 }
 
@@ -54,19 +67,18 @@ static void THREAD_Entry(void *arg)
     MDS_KernelSchedulerCheck();
 }
 
-static void THREAD_Timeout(const MDS_Timer_t *timer, MDS_Arg_t *arg)
+static void THREAD_Timeout(MDS_Thread_t *thread)
 {
-    UNUSED(timer);
-
-    MDS_Thread_t *thread = (MDS_Thread_t *)arg;
-
     MDS_ASSERT(thread != NULL);
     MDS_ASSERT(MDS_ObjectGetType(&(thread->object)) == MDS_OBJECT_TYPE_THREAD);
 
     MDS_Lock_t lock = MDS_CriticalLock(&(thread->spinlock));
 
     MDS_ThreadState_t state = MDS_ThreadGetState(thread);
-    if (state == MDS_THREAD_STATE_SUSPENDED) {
+    if ((thread->state & MDS_THREAD_FLAG_THROTTLE) != 0U) {
+        thread->state &= ~MDS_THREAD_FLAG_THROTTLE;
+        MDS_SchedulerInsertThread(thread);  // budget replenished, keep err of running thread
+    } else if (state == MDS_THREAD_STATE_SUSPENDED) {
         MDS_SchedulerInsertThread(thread);
         thread->err = MDS_ETIMEOUT;
     } else {
@@ -75,8 +87,6 @@ static void THREAD_Timeout(const MDS_Timer_t *timer, MDS_Arg_t *arg)
     }
 
     MDS_CriticalRestore(&(thread->spinlock), lock);
-
-    MDS_KernelSchedulerCheck();
 }
 
 static MDS_Err_t THREAD_Init(MDS_Thread_t *thread, MDS_ThreadEntry_t entry, MDS_Arg_t *arg,
@@ -90,6 +100,7 @@ static MDS_Err_t THREAD_Init(MDS_Thread_t *thread, MDS_ThreadEntry_t entry, MDS_
 
     MDS_SpinLockInit(&(thread->spinlock));
     MDS_DListInitNode(&(thread->nodeWait.node));
+    thread->nodeWait.queue = NULL;
 
     thread->entry = entry;
     thread->arg = arg;
@@ -102,8 +113,8 @@ static MDS_Err_t THREAD_Init(MDS_Thread_t *thread, MDS_ThreadEntry_t entry, MDS_
 
     thread->initTick = timeout.ticks;
     thread->remainTick = timeout.ticks;
-    thread->err = MDS_TimerInit(&(thread->timer), thread->object.name, THREAD_Timeout, NULL,
-                                (MDS_Arg_t *)thread);
+    thread->err = MDS_EOK;
+    MDS_DListInitNode(&(thread->nodeTimeout));
 
     thread->initPrio = priority;
     thread->currPrio = priority;
@@ -112,6 +123,23 @@ static MDS_Err_t THREAD_Init(MDS_Thread_t *thread, MDS_ThreadEntry_t entry, MDS_
     thread->eventOpt = MDS_EVENT_OPT_NONE;
     thread->eventMask = 0U;
 
+    MDS_DListInitNode(&(thread->listHold));
+    thread->mutexWait = NULL;
+
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+    thread->edfPeriod = 0;
+    thread->edfMissed = 0;
+#endif
+
+#if (defined(CONFIG_MDS_KERNEL_BUDGET_ENABLE) && (CONFIG_MDS_KERNEL_BUDGET_ENABLE != 0))
+    thread->budgetInit = 0;
+    thread->budgetThrottled = 0;
+#endif
+
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+    MDS_MemBuffSet(&(thread->stats), 0, sizeof(thread->stats));
+#endif
+
     MDS_HOOK_CALL(KERNEL, thread, (thread, MDS_KERNEL_TRACE_THREAD_INIT));
 
     return (thread->err);
@@ -204,7 +232,7 @@ MDS_Err_t MDS_ThreadStartup(MDS_Thread_t *thread)
     if (state != MDS_THREAD_STATE_INACTIVED) {
         err = MDS_EACCES;
     } else {
-        MDS_TimerStop(&(thread->timer));
+        MDS_ThreadTimeoutStop(thread);
 
         MDS_SchedulerRemoveThread(thread);
 
@@ -237,7 +265,8 @@ MDS_Err_t MDS_ThreadResume(MDS_Thread_t *thread)
     if (state != MDS_THREAD_STATE_SUSPENDED) {
         err = MDS_EACCES;
     } else {
-        MDS_TimerStop(&(thread->timer));
+        MDS_ThreadTimeoutStop(thread);
+        thread->state &= ~MDS_THREAD_FLAG_THROTTLE;
 
         MDS_SchedulerRemoveThread(thread);
 
@@ -268,7 +297,8 @@ MDS_Err_t MDS_ThreadSuspend(MDS_Thread_t *thread)
     if ((state != MDS_THREAD_STATE_READY) && (state != MDS_THREAD_STATE_RUNNING)) {
         err = MDS_EAGAIN;
     } else {
-        MDS_TimerStop(&(thread->timer));
+        MDS_ThreadTimeoutStop(thread);
+        thread->state &= ~MDS_THREAD_FLAG_THROTTLE;
 
         MDS_SchedulerRemoveThread(thread);
         MDS_ThreadSetState(thread, MDS_THREAD_STATE_SUSPENDED);
@@ -331,7 +361,7 @@ MDS_Err_t MDS_ThreadDelay(MDS_Timeout_t timeout)
         MDS_ThreadSetYield(thread);
     } else {
         MDS_ThreadSuspend(thread);
-        MDS_SysTimerStart(&(thread->timer), timeout, MDS_TIMEOUT_NO_WAIT);
+        MDS_ThreadTimeoutStart(thread, timeout);
     }
 
     MDS_CoreInterruptRestore(lock);
@@ -364,6 +394,198 @@ MDS_Err_t MDS_ThreadYield(void)
     return (thread->err);
 }
 
+#if (defined(CONFIG_MDS_KERNEL_EDF_ENABLE) && (CONFIG_MDS_KERNEL_EDF_ENABLE != 0))
+MDS_Err_t MDS_ThreadSetDeadline(MDS_Thread_t *thread, MDS_Timeout_t period,
+                                MDS_Timeout_t deadline, MDS_Timeout_t runtime)
+{
+    MDS_ASSERT(thread != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(thread->object)) == MDS_OBJECT_TYPE_THREAD);
+
+    if (deadline.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+        deadline = period;
+    }
+
+    if ((period.ticks >= MDS_CLOCK_TICK_TIMER_MAX) || (deadline.ticks > period.ticks) ||
+        (runtime.ticks > deadline.ticks)) {
+        return (MDS_EINVAL);
+    }
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(thread->spinlock));
+
+    MDS_Err_t err = MDS_SchedulerAdmitDeadline(
+        runtime.ticks, deadline.ticks, (thread->edfPeriod != 0) ? (thread->edfRuntime) : (0),
+        (thread->edfPeriod != 0) ? (thread->edfRelative) : (0));
+    if (err == MDS_EOK) {
+        bool isReady = (MDS_ThreadGetState(thread) == MDS_THREAD_STATE_READY);
+        if (isReady) {
+            MDS_SchedulerRemoveThread(thread);
+        }
+
+        thread->edfPeriod = period.ticks;
+        thread->edfRelative = deadline.ticks;
+        thread->edfRuntime = runtime.ticks;
+        thread->edfRelease = MDS_ClockGetTickCount();
+        thread->edfDeadline = thread->edfRelease + deadline.ticks;
+        thread->edfMissed = 0;
+
+        if (isReady) {
+            MDS_SchedulerInsertThread(thread);
+        }
+    }
+
+    MDS_CriticalRestore(&(thread->spinlock), lock);
+
+    MDS_LOG_D("[thread] thread(%p) entry:%p set period:%lu deadline:%lu runtime:%lu err:%d",
+              thread, thread->entry, (unsigned long)period.ticks, (unsigned long)deadline.ticks,
+              (unsigned long)runtime.ticks, err);
+
+    return (err);
+}
+
+MDS_Err_t MDS_ThreadWaitPeriod(void)
+{
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    if ((thread == NULL) || (thread->edfPeriod == 0)) {
+        return (MDS_EACCES);
+    }
+
+    MDS_Err_t err = MDS_EOK;
+
+    MDS_Lock_t lock = MDS_CoreInterruptLock();
+
+    MDS_Tick_t currTick = MDS_ClockGetTickCount();
+    MDS_Tick_t lateTick = currTick - thread->edfDeadline;
+    if ((lateTick > 0) && (lateTick < MDS_CLOCK_TICK_TIMER_MAX)) {
+        thread->edfMissed += 1;
+        err = MDS_ETIMEOUT;
+    }
+
+    // overrun job releases next one at once
+    thread->edfRelease += thread->edfPeriod;
+    MDS_Tick_t waitTick = thread->edfRelease - currTick;
+    if (waitTick >= MDS_CLOCK_TICK_TIMER_MAX) {
+        thread->edfRelease = currTick;
+        waitTick = 0;
+    }
+    thread->edfDeadline = thread->edfRelease + thread->edfRelative;
+
+    if (waitTick > 0) {
+        MDS_ThreadSuspend(thread);
+        MDS_ThreadTimeoutStart(thread, MDS_TIMEOUT_TICKS(waitTick));
+    }
+
+    MDS_CoreInterruptRestore(lock);
+
+    MDS_KernelSchedulerCheck();
+
+    return (err);
+}
+
+size_t MDS_ThreadGetDeadlineMissed(const MDS_Thread_t *thread)
+{
+    MDS_ASSERT(thread != NULL);
+
+    return (thread->edfMissed);
+}
+#endif
+
+#if (defined(CONFIG_MDS_KERNEL_BUDGET_ENABLE) && (CONFIG_MDS_KERNEL_BUDGET_ENABLE != 0))
+static void THREAD_BudgetRefill(MDS_Thread_t *thread, MDS_Tick_t currTick)
+{
+    MDS_Tick_t lateTick = currTick - thread->budgetRefill;
+    if (lateTick >= MDS_CLOCK_TICK_TIMER_MAX) {
+        return;
+    }
+
+    thread->budgetRemain = thread->budgetInit;
+    thread->state &= ~MDS_THREAD_FLAG_THROTTLE;
+    if (lateTick < thread->budgetPeriod) {
+        thread->budgetRefill += thread->budgetPeriod;
+    } else {
+        thread->budgetRefill = currTick + thread->budgetPeriod;
+    }
+}
+
+// charged whole ticks to the thread running at the tick, a thread blocking within a tick is not
+static bool THREAD_BudgetCharge(MDS_Thread_t *thread, MDS_Tick_t ticks)
+{
+    if (thread->budgetInit == 0) {
+        return (false);
+    }
+
+    MDS_Tick_t currTick = MDS_ClockGetTickCount();
+
+    THREAD_BudgetRefill(thread, currTick);
+    thread->budgetRemain = (thread->budgetRemain > ticks) ? (thread->budgetRemain - ticks) : (0);
+    if ((thread->budgetRemain > 0) || (MDS_ThreadGetState(thread) != MDS_THREAD_STATE_RUNNING)) {
+        return (false);
+    }
+
+    // throttle until replenishment, resumed by thread timeout
+    thread->budgetThrottled += 1;
+    MDS_ThreadSuspend(thread);
+    thread->state |= MDS_THREAD_FLAG_THROTTLE;
+    MDS_ThreadTimeoutStart(thread, MDS_TIMEOUT_TICKS(thread->budgetRefill - currTick));
+
+    MDS_LOG_D("[thread] thread(%p) entry:%p throttled until tick:%lu", thread, thread->entry,
+              (unsigned long)(thread->budgetRefill));
+
+    return (true);
+}
+
+MDS_Err_t MDS_ThreadSetBudget(MDS_Thread_t *thread, MDS_Timeout_t budget, MDS_Timeout_t period)
+{
+    MDS_ASSERT(thread != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(thread->object)) == MDS_OBJECT_TYPE_THREAD);
+
+    if ((period.ticks >= MDS_CLOCK_TICK_TIMER_MAX) || (budget.ticks > period.ticks)) {
+        return (MDS_EINVAL);
+    }
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(thread->spinlock));
+
+    thread->budgetInit = budget.ticks;
+    thread->budgetPeriod = period.ticks;
+    thread->budgetRemain = budget.ticks;
+    thread->budgetRefill = MDS_ClockGetTickCount() + period.ticks;
+    if ((thread->state & MDS_THREAD_FLAG_THROTTLE) != 0U) {
+        MDS_ThreadTimeoutStop(thread);
+        thread->state &= ~MDS_THREAD_FLAG_THROTTLE;
+        MDS_SchedulerInsertThread(thread);  // budget refilled, end the throttle early
+    }
+
+    MDS_CriticalRestore(&(thread->spinlock), lock);
+
+    return (MDS_EOK);
+}
+
+MDS_Tick_t MDS_ThreadGetBudgetUsed(const MDS_Thread_t *thread)
+{
+    MDS_ASSERT(thread != NULL);
+
+    return (thread->budgetInit - thread->budgetRemain);
+}
+
+size_t MDS_ThreadGetThrottled(const MDS_Thread_t *thread)
+{
+    MDS_ASSERT(thread != NULL);
+
+    return (thread->budgetThrottled);
+}
+#endif
+
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+void MDS_ThreadGetStats(MDS_Thread_t *thread, MDS_ThreadStats_t *stats)
+{
+    MDS_ASSERT(thread != NULL);
+    MDS_ASSERT(stats != NULL);
+
+    MDS_Lock_t lock = MDS_CoreInterruptLock();
+    *stats = thread->stats;
+    MDS_CoreInterruptRestore(lock);
+}
+#endif
+
 void MDS_ThreadRemainTicks(MDS_Tick_t ticks)
 {
     MDS_Thread_t *thread = MDS_KernelCurrentThread();
@@ -373,6 +595,14 @@ void MDS_ThreadRemainTicks(MDS_Tick_t ticks)
 
     MDS_Lock_t lock = MDS_CoreInterruptLock();
 
+#if (defined(CONFIG_MDS_KERNEL_BUDGET_ENABLE) && (CONFIG_MDS_KERNEL_BUDGET_ENABLE != 0))
+    if (THREAD_BudgetCharge(thread, ticks)) {
+        MDS_CoreInterruptRestore(lock);
+        MDS_KernelSchedulerCheck();
+        return;
+    }
+#endif
+
     if (thread->remainTick > ticks) {
         thread->remainTick -= ticks;
     } else {
@@ -391,3 +621,83 @@ void MDS_ThreadRemainTicks(MDS_Tick_t ticks)
         MDS_KernelSchedulerCheck();
     }
 }
+
+void MDS_ThreadTimeoutStart(MDS_Thread_t *thread, MDS_Timeout_t timeout)
+{
+    if (timeout.ticks >= MDS_CLOCK_TICK_TIMER_MAX) {
+        return;  // forever wait never arms a timeout
+    }
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_sysThreadTimeout.spinlock));
+
+    MDS_Tick_t currTick = MDS_ClockGetTickCount();
+    thread->tickTimeout = currTick + timeout.ticks;
+
+    // waits mostly use similar timeouts, search from the latest deadline, an overdue one included
+    MDS_DListRemoveNode(&(thread->nodeTimeout));
+    MDS_Thread_t *iter = NULL;
+    MDS_DLIST_FOREACH_PREV (iter, nodeTimeout, &(g_sysThreadTimeout.list)) {
+        if ((thread->tickTimeout - iter->tickTimeout) < MDS_CLOCK_TICK_TIMER_MAX) {
+            break;
+        }
+    }
+    MDS_DListInsertNodeNext(&(iter->nodeTimeout), &(thread->nodeTimeout));
+
+    MDS_CriticalRestore(&(g_sysThreadTimeout.spinlock), lock);
+}
+
+void MDS_ThreadTimeoutStop(MDS_Thread_t *thread)
+{
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_sysThreadTimeout.spinlock));
+
+    MDS_DListRemoveNode(&(thread->nodeTimeout));
+
+    MDS_CriticalRestore(&(g_sysThreadTimeout.spinlock), lock);
+}
+
+void MDS_ThreadTimeoutCheck(void)
+{
+    bool reSchedule = false;
+    MDS_Tick_t currTick = MDS_ClockGetTickCount();
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_sysThreadTimeout.spinlock));
+
+    while (!MDS_DListIsEmpty(&(g_sysThreadTimeout.list))) {
+        MDS_Thread_t *thread = CONTAINER_OF(g_sysThreadTimeout.list.next, MDS_Thread_t,
+                                            nodeTimeout);
+        if ((currTick - thread->tickTimeout) >= MDS_CLOCK_TICK_TIMER_MAX) {
+            break;
+        }
+
+        MDS_DListRemoveNode(&(thread->nodeTimeout));
+
+        MDS_CriticalRestore(&(g_sysThreadTimeout.spinlock), lock);
+
+        THREAD_Timeout(thread);
+        reSchedule = true;
+
+        lock = MDS_CriticalLock(&(g_sysThreadTimeout.spinlock));
+    }
+
+    MDS_CriticalRestore(&(g_sysThreadTimeout.spinlock), lock);
+
+    if (reSchedule) {
+        MDS_KernelSchedulerCheck();
+    }
+}
+
+MDS_Tick_t MDS_ThreadTimeoutNextTick(void)
+{
+    MDS_Tick_t ticknext = MDS_CLOCK_TICK_FOREVER;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(g_sysThreadTimeout.spinlock));
+
+    if (!MDS_DListIsEmpty(&(g_sysThreadTimeout.list))) {
+        ticknext = CONTAINER_OF(g_sysThreadTimeout.list.next, MDS_Thread_t, nodeTimeout)
+                       ->tickTimeout;
+    }
+
+    MDS_CriticalRestore(&(g_sysThreadTimeout.spinlock), lock);
+
+    return (ticknext);
+}
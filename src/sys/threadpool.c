@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) [2022] [pchom]
+ * [MDS] is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ **/
+/* Include ----------------------------------------------------------------- */
+#include "kernel.h"
+
+/* Define ------------------------------------------------------------------ */
+MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
+
+/* Function ---------------------------------------------------------------- */
+static void POOL_WorkerEntry(MDS_Arg_t *arg)
+{
+    MDS_ThreadPoolWorker_t *worker = (MDS_ThreadPoolWorker_t *)arg;
+    MDS_ThreadPool_t *pool = worker->pool;
+
+    for (;;) {
+        MDS_Lock_t lock = MDS_CriticalLock(&(pool->spinlock));
+
+        // park back to pool instead of exit, let a waiting dispatcher take it
+        worker->entry = NULL;
+        worker->arg = NULL;
+        MDS_KernelWaitQueueResume(&(pool->queueWait));
+        MDS_KernelWaitQueueSuspend(&(pool->queueIdle), worker->thread, MDS_TIMEOUT_FOREVER,
+                                   false);
+
+        MDS_CriticalRestore(&(pool->spinlock), lock);
+
+        MDS_KernelSchedulerCheck();
+
+        if (worker->entry != NULL) {
+            MDS_LOG_D("[threadpool] thread(%p) run job entry:%p", worker->thread, worker->entry);
+            worker->entry(worker->arg);
+        }
+    }
+}
+
+static void POOL_Init(MDS_ThreadPool_t *pool, MDS_ThreadPoolWorker_t *workers)
+{
+    MDS_SpinLockInit(&(pool->spinlock));
+    MDS_KernelWaitQueueInit(&(pool->queueIdle));
+    MDS_KernelWaitQueueInit(&(pool->queueWait));
+    pool->workers = workers;
+    pool->nworkers = 0;
+}
+
+static void POOL_Startup(MDS_ThreadPool_t *pool)
+{
+    for (size_t idx = 0; idx < pool->nworkers; idx++) {
+        MDS_ThreadStartup(pool->workers[idx].thread);
+    }
+}
+
+static MDS_Err_t POOL_Close(MDS_ThreadPool_t *pool, MDS_Err_t (*close)(MDS_Thread_t *thread))
+{
+    MDS_Err_t err = MDS_EOK;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(pool->spinlock));
+
+    MDS_KernelWaitQueueDrain(&(pool->queueWait));
+    while ((err == MDS_EOK) && (pool->nworkers > 0)) {
+        err = close(pool->workers[pool->nworkers - 1].thread);
+        if (err == MDS_EOK) {
+            pool->nworkers -= 1;
+        }
+    }
+
+    MDS_CriticalRestore(&(pool->spinlock), lock);
+
+    return (err);
+}
+
+MDS_Err_t MDS_ThreadPoolInit(MDS_ThreadPool_t *pool, const char *name, MDS_Thread_t threads[],
+                             MDS_ThreadPoolWorker_t workers[], size_t nthreads, void *stackPool,
+                             size_t stackSize, MDS_ThreadPriority_t priority,
+                             MDS_Timeout_t timeout)
+{
+    MDS_ASSERT(pool != NULL);
+    MDS_ASSERT(threads != NULL);
+    MDS_ASSERT(workers != NULL);
+    MDS_ASSERT(nthreads > 0);
+    MDS_ASSERT(stackPool != NULL);
+
+    MDS_Err_t err = MDS_ObjectInit(&(pool->object), MDS_OBJECT_TYPE_THREADPOOL, name);
+    if (err != MDS_EOK) {
+        return (err);
+    }
+
+    POOL_Init(pool, workers);
+    while (pool->nworkers < nthreads) {
+        MDS_ThreadPoolWorker_t *worker = &(workers[pool->nworkers]);
+
+        worker->pool = pool;
+        worker->thread = &(threads[pool->nworkers]);
+        err = MDS_ThreadInit(worker->thread, name, POOL_WorkerEntry, (MDS_Arg_t *)worker,
+                             (uint8_t *)stackPool + (pool->nworkers * stackSize), stackSize,
+                             priority, timeout);
+        if (err != MDS_EOK) {
+            break;
+        }
+        pool->nworkers += 1;
+    }
+
+    if (err == MDS_EOK) {
+        POOL_Startup(pool);
+    } else {
+        POOL_Close(pool, MDS_ThreadDeInit);
+        MDS_ObjectDeInit(&(pool->object));
+    }
+
+    return (err);
+}
+
+MDS_Err_t MDS_ThreadPoolDeInit(MDS_ThreadPool_t *pool)
+{
+    MDS_ASSERT(pool != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(pool->object)) == MDS_OBJECT_TYPE_THREADPOOL);
+
+    MDS_Err_t err = POOL_Close(pool, MDS_ThreadDeInit);
+    if (err == MDS_EOK) {
+        MDS_ObjectDeInit(&(pool->object));
+    }
+
+    return (err);
+}
+
+MDS_ThreadPool_t *MDS_ThreadPoolCreate(const char *name, size_t nthreads, size_t stackSize,
+                                       MDS_ThreadPriority_t priority, MDS_Timeout_t timeout)
+{
+    MDS_ASSERT(nthreads > 0);
+
+    MDS_ThreadPool_t *pool = (MDS_ThreadPool_t *)MDS_ObjectCreate(
+        sizeof(MDS_ThreadPool_t) + (nthreads * sizeof(MDS_ThreadPoolWorker_t)),
+        MDS_OBJECT_TYPE_THREADPOOL, name);
+    if (pool == NULL) {
+        return (NULL);
+    }
+
+    POOL_Init(pool, (MDS_ThreadPoolWorker_t *)(pool + 1));
+    while (pool->nworkers < nthreads) {
+        MDS_ThreadPoolWorker_t *worker = &(pool->workers[pool->nworkers]);
+
+        worker->pool = pool;
+        worker->thread = MDS_ThreadCreate(name, POOL_WorkerEntry, (MDS_Arg_t *)worker, stackSize,
+                                          priority, timeout);
+        if (worker->thread == NULL) {
+            break;
+        }
+        pool->nworkers += 1;
+    }
+
+    if (pool->nworkers == nthreads) {
+        POOL_Startup(pool);
+    } else {
+        POOL_Close(pool, MDS_ThreadDestroy);
+        MDS_ObjectDestroy(&(pool->object));
+        pool = NULL;
+    }
+
+    return (pool);
+}
+
+MDS_Err_t MDS_ThreadPoolDestroy(MDS_ThreadPool_t *pool)
+{
+    MDS_ASSERT(pool != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(pool->object)) == MDS_OBJECT_TYPE_THREADPOOL);
+
+    MDS_Err_t err = POOL_Close(pool, MDS_ThreadDestroy);
+    if (err == MDS_EOK) {
+        err = MDS_ObjectDestroy(&(pool->object));
+    }
+
+    return (err);
+}
+
+MDS_Err_t MDS_ThreadPoolDispatch(MDS_ThreadPool_t *pool, MDS_ThreadEntry_t entry,
+                                 MDS_Arg_t *arg, MDS_Timeout_t timeout)
+{
+    MDS_ASSERT(pool != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(pool->object)) == MDS_OBJECT_TYPE_THREADPOOL);
+    MDS_ASSERT(entry != NULL);
+
+    MDS_Err_t err = MDS_EOK;
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
+    MDS_Thread_t *idle = NULL;
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(pool->spinlock));
+
+    if (MDS_KernelWaitQueuePeek(&(pool->queueIdle)) == NULL) {
+        if (timeout.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+            err = MDS_ETIMEOUT;
+        } else if (thread == NULL) {
+            MDS_LOG_W("[threadpool] thread is null try to dispatch threadpool");
+            err = MDS_EACCES;
+        } else {
+            thread->err = MDS_EOK;
+        }
+    }
+
+    while ((err == MDS_EOK) && ((idle = MDS_KernelWaitQueuePeek(&(pool->queueIdle))) == NULL)) {
+        err = MDS_KernelWaitQueueUntil(&(pool->queueWait), thread, timeout, true, &lock,
+                                       &(pool->spinlock));
+    }
+
+    if (err == MDS_EOK) {
+        MDS_ThreadPoolWorker_t *worker = (MDS_ThreadPoolWorker_t *)(idle->arg);
+
+        worker->entry = entry;
+        worker->arg = arg;
+        MDS_KernelWaitQueueResume(&(pool->queueIdle));
+    }
+
+    MDS_CriticalRestore(&(pool->spinlock), lock);
+
+    if (err == MDS_EOK) {
+        MDS_KernelSchedulerCheck();
+    }
+
+    return (err);
+}
+
+size_t MDS_ThreadPoolIdleCount(MDS_ThreadPool_t *pool)
+{
+    MDS_ASSERT(pool != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(pool->object)) == MDS_OBJECT_TYPE_THREADPOOL);
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(pool->spinlock));
+
+    size_t count = MDS_DListGetCount(&(pool->queueIdle.list));
+
+    MDS_CriticalRestore(&(pool->spinlock), lock);
+
+    return (count);
+}
@@ -42,6 +42,8 @@ void MDS_SysTimerInit(void)
 {
     MDS_SpinLockInit(&(g_sysTimerQueue.spinlock));
     MDS_SkipListInitNode(g_sysTimerQueue.list, ARRAY_SIZE(g_sysTimerQueue.list));
+    MDS_DListInitNode(&(g_sysTimerQueue.listReady));
+    MDS_DListInitNode(&(g_sysTimerQueue.listRun));
 
 #if (defined(CONFIG_MDS_TIMER_INDEPENDENT) && (CONFIG_MDS_TIMER_INDEPENDENT != 0))
     MDS_Err_t err = MDS_WorkQueueInit(&g_sysWorkQueue, "workq", &g_sysWorkqThread,
@@ -49,7 +51,7 @@ void MDS_SysTimerInit(void)
                                       MDS_THREAD_PRIORITY(CONFIG_MDS_TIMER_THREAD_PRIORITY),
                                       MDS_TIMEOUT_TICKS(CONFIG_MDS_TIMER_THREAD_TICKS));
     if (err == MDS_EOK) {
-        MDS_WorkQueueStart(&g_sysTimerQueue);
+        MDS_WorkQueueStart(&g_sysWorkQueue);
     } else {
         MDS_LOG_W("[timer] soft timer queue init failed: %d", err);
     }
@@ -109,7 +111,23 @@ MDS_Err_t MDS_TimerStop(MDS_Timer_t *timer)
     return (MDS_WorkNodeCancle(timer));
 }
 
+MDS_Err_t MDS_TimerSetSlack(MDS_Timer_t *timer, MDS_Timeout_t slack)
+{
+    return (MDS_WorkNodeSetSlack(timer, slack));
+}
+
 bool MDS_TimerIsActive(const MDS_Timer_t *timer)
 {
     return (MDS_WorkNodeIsSubmit(timer));
 }
+
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+void MDS_TimerGetStats(MDS_WorkQueueStats_t *stats)
+{
+#if (defined(CONFIG_MDS_TIMER_INDEPENDENT) && (CONFIG_MDS_TIMER_INDEPENDENT != 0))
+    MDS_WorkQueueGetStats(&g_sysWorkQueue, stats);
+#else
+    MDS_WorkQueueGetStats(&g_sysTimerQueue, stats);
+#endif
+}
+#endif
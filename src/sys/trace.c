@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) [2022] [pchom]
+ * [MDS] is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *          http://license.coscl.org.cn/MulanPSL2
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ **/
+/* Include ----------------------------------------------------------------- */
+#include "kernel.h"
+
+#if (defined(CONFIG_MDS_KERNEL_TRACE_ENABLE) && (CONFIG_MDS_KERNEL_TRACE_ENABLE != 0))
+/* Define ------------------------------------------------------------------ */
+#ifndef CONFIG_MDS_KERNEL_TRACE_RECORDS
+#define CONFIG_MDS_KERNEL_TRACE_RECORDS 256
+#endif
+
+/* Variable ---------------------------------------------------------------- */
+typedef struct TraceRing {
+    size_t head;  // next record to write
+    size_t tail;  // next record to dump
+    uint32_t lost;
+    MDS_TraceRecord_t records[CONFIG_MDS_KERNEL_TRACE_RECORDS];
+} TraceRing_t;
+
+static struct {
+    volatile bool enable;
+    TraceRing_t ring[CONFIG_MDS_KERNEL_SMP_CPUS];
+} g_sysTrace;
+
+/* Function ---------------------------------------------------------------- */
+static void TRACE_Record(MDS_KERNEL_Trace_t id, const void *object, MDS_Err_t err, uintptr_t arg)
+{
+    if (!g_sysTrace.enable) {
+        return;
+    }
+
+    // each cpu only writes its own ring, masking interrupt is enough
+    MDS_Lock_t lock = MDS_CoreInterruptLock();
+
+    size_t cpu = 0;  // cpuInfo
+    TraceRing_t *ring = &(g_sysTrace.ring[cpu]);
+    MDS_TraceRecord_t *record = &(ring->records[ring->head % CONFIG_MDS_KERNEL_TRACE_RECORDS]);
+
+    record->timestamp = MDS_CoreCycleCount();
+    record->cpu = (uint8_t)cpu;
+    record->id = (uint8_t)id;
+    record->err = (int16_t)err;
+    record->object = (uintptr_t)object;
+    record->arg = arg;
+
+    ring->head += 1;
+    if ((ring->head - ring->tail) > CONFIG_MDS_KERNEL_TRACE_RECORDS) {
+        ring->tail += 1;
+        ring->lost += 1;
+    }
+
+    MDS_CoreInterruptRestore(lock);
+}
+
+static void TRACE_Scheduler(const MDS_Thread_t *toThread, const MDS_Thread_t *fromThread)
+{
+    TRACE_Record(MDS_KERNEL_TRACE_SCHEDULER_SWITCH, toThread, MDS_EOK, (uintptr_t)fromThread);
+}
+
+static void TRACE_Thread(const MDS_Thread_t *thread, MDS_KERNEL_Trace_t id)
+{
+    TRACE_Record(id, thread, MDS_EOK, 0);
+}
+
+static void TRACE_Timer(const MDS_Timer_t *timer, MDS_KERNEL_Trace_t id)
+{
+    TRACE_Record(id, timer, MDS_EOK, 0);
+}
+
+static void TRACE_MemHeap(const MDS_MemHeap_t *memheap, MDS_KERNEL_Trace_t id, void *free_begin,
+                          void *alloc_limit, size_t size)
+{
+    UNUSED(free_begin);
+    UNUSED(alloc_limit);
+
+    TRACE_Record(id, memheap, MDS_EOK, size);
+}
+
+static void TRACE_Semaphore(const MDS_Semaphore_t *semaphore, MDS_KERNEL_Trace_t id,
+                            MDS_Err_t err, MDS_Timeout_t timeout)
+{
+    TRACE_Record(id, semaphore, err, timeout.ticks);
+}
+
+static void TRACE_Mutex(const MDS_Mutex_t *mutex, MDS_KERNEL_Trace_t id, MDS_Err_t err,
+                        MDS_Timeout_t timeout)
+{
+    TRACE_Record(id, mutex, err, timeout.ticks);
+}
+
+static void TRACE_Event(const MDS_Event_t *event, MDS_KERNEL_Trace_t id, MDS_Err_t err,
+                        MDS_Timeout_t timeout)
+{
+    TRACE_Record(id, event, err, timeout.ticks);
+}
+
+static void TRACE_MsgQueue(const MDS_MsgQueue_t *msgqueue, MDS_KERNEL_Trace_t id, MDS_Err_t err,
+                           MDS_Timeout_t timeout)
+{
+    TRACE_Record(id, msgqueue, err, timeout.ticks);
+}
+
+static void TRACE_MemPool(const MDS_MemPool_t *mempool, MDS_KERNEL_Trace_t id, MDS_Err_t err,
+                          MDS_Timeout_t timeout, void *blk)
+{
+    UNUSED(timeout);
+
+    TRACE_Record(id, mempool, err, (uintptr_t)blk);
+}
+
+MDS_HOOK_DEFINE(KERNEL, MDS_HOOK_Kernel_t,
+                (.scheduler = TRACE_Scheduler, .thread = TRACE_Thread, .timer = TRACE_Timer,
+                 .memheap = TRACE_MemHeap, .semaphore = TRACE_Semaphore, .mutex = TRACE_Mutex,
+                 .event = TRACE_Event, .msgqueue = TRACE_MsgQueue, .mempool = TRACE_MemPool));
+
+void MDS_TraceStart(void)
+{
+    g_sysTrace.enable = true;
+}
+
+void MDS_TraceStop(void)
+{
+    g_sysTrace.enable = false;
+}
+
+size_t MDS_TraceDump(void *buff, size_t size)
+{
+    MDS_ASSERT(buff != NULL);
+
+    if (size < sizeof(MDS_TraceHeader_t)) {
+        return (0);
+    }
+
+    MDS_TraceHeader_t *header = (MDS_TraceHeader_t *)buff;
+    MDS_TraceRecord_t *record = (MDS_TraceRecord_t *)(header + 1);
+    size_t count = (size - sizeof(MDS_TraceHeader_t)) / sizeof(MDS_TraceRecord_t);
+
+    header->magic = MDS_TRACE_MAGIC;
+    header->version = MDS_TRACE_VERSION;
+    header->recordSize = sizeof(MDS_TraceRecord_t);
+    header->pointerSize = sizeof(uintptr_t);
+    header->count = 0;
+    header->lost = 0;
+
+    // drain oldest first per cpu, records of other cpus are merged by timestamp on the host
+    for (size_t cpu = 0; cpu < ARRAY_SIZE(g_sysTrace.ring); cpu++) {
+        TraceRing_t *ring = &(g_sysTrace.ring[cpu]);
+
+        MDS_Lock_t lock = MDS_CoreInterruptLock();
+
+        while ((ring->tail != ring->head) && (header->count < count)) {
+            record[header->count] = ring->records[ring->tail % CONFIG_MDS_KERNEL_TRACE_RECORDS];
+            ring->tail += 1;
+            header->count += 1;
+        }
+        header->lost += ring->lost;
+        ring->lost = 0;
+
+        MDS_CoreInterruptRestore(lock);
+    }
+
+    return (sizeof(MDS_TraceHeader_t) + (header->count * sizeof(MDS_TraceRecord_t)));
+}
+#endif
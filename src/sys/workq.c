@@ -15,6 +15,11 @@
 /* Define ------------------------------------------------------------------ */
 MDS_LOG_MODULE_DECLARE(kernel, CONFIG_MDS_KERNEL_LOG_LEVEL);
 
+typedef struct WorkQueueRun {
+    MDS_DListNode_t node;
+    MDS_WorkNode_t *workn;  // NULL once canceled, the node may be freed by its entry
+} WorkQueueRun_t;
+
 /* WorkQueue --------------------------------------------------------------- */
 static int WORKQ_SkipListCompare(const MDS_DListNode_t *node, const void *value)
 {
@@ -41,11 +46,62 @@ static MDS_WorkNode_t *WORKQ_SkipListPeek(const MDS_WorkQueue_t *workq)
     return (workn);
 }
 
+static MDS_WorkNode_t *WORKQ_SkipListDue(const MDS_WorkQueue_t *workq)
+{
+    MDS_WorkNode_t *workn = WORKQ_SkipListPeek(workq);
+
+    if ((workn != NULL) &&
+        ((MDS_ClockGetTickCount() - workn->tickout) >= MDS_CLOCK_TICK_TIMER_MAX)) {
+        workn = NULL;
+    }
+
+    return (workn);
+}
+
+static MDS_WorkNode_t *WORKQ_ReadyPeek(const MDS_WorkQueue_t *workq)
+{
+    MDS_WorkNode_t *workn = NULL;
+
+    if (!MDS_DListIsEmpty(&(workq->listReady))) {
+        workn = CONTAINER_OF(workq->listReady.next, MDS_WorkNode_t,
+                             node[ARRAY_SIZE(workq->list) - 1]);
+    }
+
+    return (workn);
+}
+
+static void WORKQ_ReadyAppend(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn)
+{
+    MDS_DListInsertNodePrev(&(workq->listReady), &(workn->node[ARRAY_SIZE(workn->node) - 1]));
+}
+
 static void WORKQ_SkipListRemove(MDS_WorkNode_t *workn)
 {
     MDS_SkipListRemoveNode(workn->node, ARRAY_SIZE(workn->node));
 }
 
+static void WORKQ_SkipListCoalesce(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn,
+                                   const MDS_DListNode_t *last)
+{
+    const MDS_DListNode_t *list = &(workq->list[ARRAY_SIZE(workq->list) - 1]);
+
+    // join the next expiry inside slack window
+    if (last->next != list) {
+        const MDS_WorkNode_t *workl = CONTAINER_OF(last->next, MDS_WorkNode_t,
+                                                   node[ARRAY_SIZE(workq->list) - 1]);
+        if ((workl->tickout - workn->tickout) <= workn->tslack) {
+            workn->tickout = workl->tickout;
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+            workq->stats.coalesced += 1;
+#endif
+            return;
+        }
+    }
+
+    // round up to slack boundary, so later works with same slack meet it
+    workn->tickout += (workn->tslack - (workn->tickout % workn->tslack)) % workn->tslack;
+}
+
 static void WORKQ_SkipListInsert(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn, MDS_Tick_t tickout)
 {
     static size_t skipRand = 0;
@@ -56,6 +112,9 @@ static void WORKQ_SkipListInsert(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn,
     workn->tickout = tickcurr + tickout;
     MDS_SkipListSearchNode(skipNode, workq->list, ARRAY_SIZE(workq->list), workn,
                            WORKQ_SkipListCompare);
+    if (workn->tslack > 0) {
+        WORKQ_SkipListCoalesce(workq, workn, skipNode[ARRAY_SIZE(workq->list) - 1]);
+    }
 
     skipRand = skipRand + tickcurr + 1;
     MDS_SkipListInsertNode(skipNode, workn->node, ARRAY_SIZE(workn->node), skipRand,
@@ -70,13 +129,16 @@ static void WORKQ_SkipListDrain(MDS_WorkQueue_t *workq, MDS_Lock_t *lock)
 
     MDS_DListNode_t stopList = MDS_DLIST_INIT(stopList);
 
-    while (!MDS_DListIsEmpty(&(workq->list[ARRAY_SIZE(workq->list) - 1]))) {
-        MDS_WorkNode_t *workn = WORKQ_SkipListPeek(workq);
+    MDS_WorkNode_t *workn = NULL;
 
+    while (((workn = WORKQ_ReadyPeek(workq)) != NULL) ||
+           ((workn = WORKQ_SkipListPeek(workq)) != NULL)) {
         MDS_HOOK_CALL(KERNEL, timer, (workn, MDS_KERNEL_TRACE_TIMER_STOP));
 
         WORKQ_SkipListRemove(workn);
         MDS_DListInsertNodeNext(&stopList, &(workn->node[ARRAY_SIZE(workn->node) - 1]));
+        workn->queue = NULL;
+        workn->pending = false;
 
         if (workn->stop != NULL) {
             MDS_CriticalRestore(&(workq->spinlock), *lock);
@@ -92,84 +154,171 @@ static void WORKQ_SkipListDrain(MDS_WorkQueue_t *workq, MDS_Lock_t *lock)
     }
 }
 
-void MDS_WorkQueueCheck(MDS_WorkQueue_t *workq, MDS_Lock_t *lock)
+static MDS_WorkNode_t *WORKQ_Dispatch(MDS_WorkQueue_t *workq)
 {
-    if ((workq->list[0].next == NULL) || (workq->list[0].prev == NULL)) {
-        MDS_SkipListInitNode(workq->list, ARRAY_SIZE(workq->list));
-        return;
+    MDS_WorkNode_t *workn = NULL;
+
+    while (((workn = WORKQ_ReadyPeek(workq)) != NULL) ||
+           ((workn = WORKQ_SkipListDue(workq)) != NULL)) {
+        WORKQ_SkipListRemove(workn);
+        if (workn->running < workn->concurrency) {
+            workn->running += 1;
+            break;
+        }
+
+        // rerun by the last running worker
+        workn->pending = true;
     }
 
-    MDS_DListNode_t runList = MDS_DLIST_INIT(runList);
+    return (workn);
+}
 
-    while (!MDS_DListIsEmpty(&(workq->list[ARRAY_SIZE(workq->list) - 1]))) {
-        MDS_WorkNode_t *workn = WORKQ_SkipListPeek(workq);
-        MDS_Tick_t tickcurr = MDS_ClockGetTickCount();
+static void WORKQ_RunDetach(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn)
+{
+    WorkQueueRun_t *iter = NULL;
 
-        if ((tickcurr - workn->tickout) >= MDS_CLOCK_TICK_TIMER_MAX) {
-            break;
+    MDS_DLIST_FOREACH_NEXT (iter, node, &(workq->listRun)) {
+        if (iter->workn == workn) {
+            iter->workn = NULL;
         }
+    }
+    workn->running = 0;
+}
 
-        MDS_HOOK_CALL(KERNEL, timer, (workn, MDS_KERNEL_TRACE_TIMER_ENTER));
+static void WORKQ_Execute(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn, MDS_Lock_t *lock,
+                          bool reSchedule)
+{
+    MDS_Tick_t tickstart = MDS_ClockGetTickCount();
 
-        WORKQ_SkipListRemove(workn);
-        MDS_DListInsertNodeNext(&runList, &(workn->node[ARRAY_SIZE(workn->node) - 1]));
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+    MDS_Tick_t latency = tickstart - workn->tickout;
+    workq->stats.latencySum += latency;
+    if (workq->stats.latencyMax < latency) {
+        workq->stats.latencyMax = latency;
+    }
+#endif
 
-        if (workn->entry != NULL) {
-            MDS_CriticalRestore(&(workq->spinlock), *lock);
-            workn->entry(workn, workn->arg);
-            *lock = MDS_CriticalLock(&(workq->spinlock));
-        }
+    MDS_HOOK_CALL(KERNEL, timer, (workn, MDS_KERNEL_TRACE_TIMER_ENTER));
 
-        MDS_HOOK_CALL(KERNEL, timer, (workn, MDS_KERNEL_TRACE_TIMER_EXIT));
+    WorkQueueRun_t run = {.workn = workn};
+    MDS_WorkEntry_t entry = workn->entry;
+    MDS_Arg_t *arg = workn->arg;
+    MDS_DListInsertNodePrev(&(workq->listRun), &(run.node));
 
-        if (MDS_DListIsEmpty(&runList)) {
-            continue;
-        }
+    MDS_CriticalRestore(&(workq->spinlock), *lock);
+    if (reSchedule) {
+        MDS_KernelSchedulerCheck();
+    }
+    if (entry != NULL) {
+        entry(workn, arg);
+    }
+    *lock = MDS_CriticalLock(&(workq->spinlock));
 
-        MDS_DListRemoveNode(&(workn->node[ARRAY_SIZE(workn->node) - 1]));
-        if (workn->tperiod > MDS_CLOCK_TICK_NO_WAIT) {
-            WORKQ_SkipListInsert(workq, workn, workn->tperiod);
+    MDS_DListRemoveNode(&(run.node));
+
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+    MDS_Tick_t runtime = MDS_ClockGetTickCount() - tickstart;
+    workq->stats.executed += 1;
+    workq->stats.runSum += runtime;
+    if (workq->stats.runMax < runtime) {
+        workq->stats.runMax = runtime;
+    }
+#else
+    UNUSED(tickstart);
+#endif
+
+    // canceled or destroyed in entry, never touch the node again
+    if (run.workn == NULL) {
+        return;
+    }
+
+    MDS_HOOK_CALL(KERNEL, timer, (workn, MDS_KERNEL_TRACE_TIMER_EXIT));
+
+    workn->running -= 1;
+
+    // submitted again in entry or elsewhere, the new submission owns the node
+    if (!MDS_DListIsEmpty(&(workn->node[ARRAY_SIZE(workn->node) - 1]))) {
+        workn->pending = false;
+        return;
+    }
+
+    if (workn->pending) {
+        workn->pending = false;
+        WORKQ_ReadyAppend(workq, workn);
+    } else if ((workn->tperiod > MDS_CLOCK_TICK_NO_WAIT) && (workn->running == 0)) {
+        WORKQ_SkipListInsert(workq, workn, workn->tperiod);
+    }
+}
+
+void MDS_WorkQueueCheck(MDS_WorkQueue_t *workq, MDS_Lock_t *lock)
+{
+    if ((workq->list[0].next == NULL) || (workq->list[0].prev == NULL)) {
+        MDS_SkipListInitNode(workq->list, ARRAY_SIZE(workq->list));
+        MDS_DListInitNode(&(workq->listReady));
+        MDS_DListInitNode(&(workq->listRun));
+        return;
+    }
+
+    MDS_WorkNode_t *workn = NULL;
+
+    while ((workn = WORKQ_Dispatch(workq)) != NULL) {
+        bool reSchedule = false;
+
+        // hand the rest of due works to an idle worker
+        if ((workq->nworkers > 1) &&
+            ((WORKQ_ReadyPeek(workq) != NULL) || (WORKQ_SkipListDue(workq) != NULL))) {
+            reSchedule = (MDS_KernelWaitQueueResume(&(workq->queueIdle)) != NULL);
         }
+
+        WORKQ_Execute(workq, workn, lock, reSchedule);
     }
 }
 
 static void WorkQueueThreadEntry(MDS_Arg_t *arg)
 {
     MDS_WorkQueue_t *workq = (MDS_WorkQueue_t *)arg;
+    MDS_Thread_t *thread = MDS_KernelCurrentThread();
 
     for (;;) {
-        MDS_Tick_t nextTick = 0;
+        MDS_Timeout_t timeout = MDS_TIMEOUT_FOREVER;
 
         MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
-        do {
-            MDS_WorkQueueCheck(workq, &lock);
-
-            MDS_WorkNode_t *workn = WORKQ_SkipListPeek(workq);
-            nextTick = (workn != NULL) ? (workn->tickout) : (MDS_CLOCK_TICK_FOREVER);
 
-            MDS_LOG_D("[workq] thread take next tick check:%lu", (unsigned long)(nextTick));
+        MDS_WorkQueueCheck(workq, &lock);
 
-            if (nextTick == MDS_CLOCK_TICK_FOREVER) {
-                MDS_ThreadSuspend(workq->thread);
-                break;
+        MDS_WorkNode_t *workn = WORKQ_SkipListPeek(workq);
+        if (WORKQ_ReadyPeek(workq) != NULL) {
+            MDS_CriticalRestore(&(workq->spinlock), lock);
+            continue;
+        } else if (workn != NULL) {
+            timeout.ticks = workn->tickout - MDS_ClockGetTickCount();
+            if ((timeout.ticks == 0) || (timeout.ticks >= MDS_CLOCK_TICK_TIMER_MAX)) {
+                MDS_CriticalRestore(&(workq->spinlock), lock);
+                continue;
             }
+        }
+
+        MDS_LOG_D("[workq] thread(%p) wait next tick:%lu", thread, (unsigned long)(timeout.ticks));
+
+        MDS_KernelWaitQueueSuspend(&(workq->queueIdle), thread, timeout, false);
 
-            MDS_Tick_t currTick = MDS_ClockGetTickCount();
-            if ((nextTick - currTick) < MDS_CLOCK_TICK_TIMER_MAX) {
-                nextTick = nextTick - currTick;
-                break;
-            }
-        } while (0);
         MDS_CriticalRestore(&(workq->spinlock), lock);
 
-        if (nextTick == MDS_CLOCK_TICK_FOREVER) {
-            MDS_KernelSchedulerCheck();
-        } else if (nextTick > 0) {
-            MDS_ThreadDelay(MDS_TIMEOUT_TICKS(nextTick));
-        }
+        MDS_KernelSchedulerCheck();
     }
 }
 
+static void WORKQ_Init(MDS_WorkQueue_t *workq, MDS_Thread_t **workers)
+{
+    MDS_SpinLockInit(&(workq->spinlock));
+    MDS_SkipListInitNode(workq->list, ARRAY_SIZE(workq->list));
+    MDS_KernelWaitQueueInit(&(workq->queueIdle));
+    MDS_DListInitNode(&(workq->listReady));
+    MDS_DListInitNode(&(workq->listRun));
+    workq->workers = workers;
+    workq->nworkers = 0;
+}
+
 MDS_Err_t MDS_WorkQueueInit(MDS_WorkQueue_t *workq, const char *name, MDS_Thread_t *thread,
                             void *stackPool, size_t stackSize, MDS_ThreadPriority_t priority,
                             MDS_Timeout_t timeout)
@@ -181,9 +330,9 @@ MDS_Err_t MDS_WorkQueueInit(MDS_WorkQueue_t *workq, const char *name, MDS_Thread
     if (err == MDS_EOK) {
         err = MDS_ObjectInit(&(workq->object), MDS_OBJECT_TYPE_WORKQUEUE, name);
         if (err == MDS_EOK) {
-            MDS_SpinLockInit(&(workq->spinlock));
-            MDS_SkipListInitNode(workq->list, ARRAY_SIZE(workq->list));
+            WORKQ_Init(workq, &(workq->thread));
             workq->thread = thread;
+            workq->nworkers = 1;
         } else {
             MDS_ThreadDeInit(thread);
         }
@@ -196,10 +345,17 @@ MDS_Err_t MDS_WorkQueueDeInit(MDS_WorkQueue_t *workq)
 {
     MDS_ASSERT(workq != NULL);
 
+    MDS_Err_t err = MDS_EOK;
+
     MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
 
     WORKQ_SkipListDrain(workq, &lock);
-    MDS_Err_t err = MDS_ThreadDeInit(workq->thread);
+    while ((err == MDS_EOK) && (workq->nworkers > 0)) {
+        err = MDS_ThreadDeInit(workq->workers[workq->nworkers - 1]);
+        if (err == MDS_EOK) {
+            workq->nworkers -= 1;
+        }
+    }
     if (err == MDS_EOK) {
         workq->thread = NULL;
         err = MDS_ObjectDeInit(&(workq->object));
@@ -213,20 +369,39 @@ MDS_Err_t MDS_WorkQueueDeInit(MDS_WorkQueue_t *workq)
 MDS_WorkQueue_t *MDS_WorkQueueCreate(const char *name, size_t stackSize,
                                      MDS_ThreadPriority_t priority, MDS_Timeout_t timeout)
 {
-    MDS_WorkQueue_t *workq = (MDS_WorkQueue_t *)MDS_ObjectCreate(sizeof(MDS_WorkQueue_t),
-                                                                 MDS_OBJECT_TYPE_WORKQUEUE, name);
+    return (MDS_WorkQueueCreatePool(name, 1, stackSize, priority, timeout));
+}
+
+MDS_WorkQueue_t *MDS_WorkQueueCreatePool(const char *name, size_t nthreads, size_t stackSize,
+                                         MDS_ThreadPriority_t priority, MDS_Timeout_t timeout)
+{
+    MDS_ASSERT(nthreads > 0);
+
+    MDS_WorkQueue_t *workq = (MDS_WorkQueue_t *)MDS_ObjectCreate(
+        sizeof(MDS_WorkQueue_t) + (nthreads * sizeof(MDS_Thread_t *)), MDS_OBJECT_TYPE_WORKQUEUE,
+        name);
     if (workq == NULL) {
         return (NULL);
     }
 
-    workq->thread = MDS_ThreadCreate(name, WorkQueueThreadEntry, (MDS_Arg_t *)workq, stackSize,
-                                     priority, timeout);
-    if (workq->thread == NULL) {
+    WORKQ_Init(workq, (MDS_Thread_t **)(workq + 1));
+    while (workq->nworkers < nthreads) {
+        MDS_Thread_t *thread = MDS_ThreadCreate(name, WorkQueueThreadEntry, (MDS_Arg_t *)workq,
+                                                stackSize, priority, timeout);
+        if (thread == NULL) {
+            break;
+        }
+        workq->workers[workq->nworkers++] = thread;
+    }
+
+    if (workq->nworkers < nthreads) {
+        while (workq->nworkers > 0) {
+            MDS_ThreadDestroy(workq->workers[--workq->nworkers]);
+        }
         MDS_ObjectDestroy(&(workq->object));
         workq = NULL;
     } else {
-        MDS_SpinLockInit(&(workq->spinlock));
-        MDS_SkipListInitNode(workq->list, ARRAY_SIZE(workq->list));
+        workq->thread = workq->workers[0];
     }
 
     return (workq);
@@ -236,10 +411,17 @@ MDS_Err_t MDS_WorkQueueDestroy(MDS_WorkQueue_t *workq)
 {
     MDS_ASSERT(workq != NULL);
 
+    MDS_Err_t err = MDS_EOK;
+
     MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
 
     WORKQ_SkipListDrain(workq, &lock);
-    MDS_Err_t err = MDS_ThreadDestroy(workq->thread);
+    while ((err == MDS_EOK) && (workq->nworkers > 0)) {
+        err = MDS_ThreadDestroy(workq->workers[workq->nworkers - 1]);
+        if (err == MDS_EOK) {
+            workq->nworkers -= 1;
+        }
+    }
     if (err == MDS_EOK) {
         workq->thread = NULL;
         err = MDS_ObjectDestroy(&(workq->object));
@@ -258,12 +440,12 @@ MDS_Err_t MDS_WorkQueueStart(MDS_WorkQueue_t *workq)
 
     MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
 
-    if (workq->thread != NULL) {
-        MDS_ThreadState_t state = MDS_ThreadGetState(workq->thread);
+    for (size_t idx = 0; idx < workq->nworkers; idx++) {
+        MDS_ThreadState_t state = MDS_ThreadGetState(workq->workers[idx]);
         if (state == MDS_THREAD_STATE_INACTIVED) {
-            err = MDS_ThreadStartup(workq->thread);
+            err = MDS_ThreadStartup(workq->workers[idx]);
         } else {
-            err = MDS_ThreadResume(workq->thread);
+            err = MDS_ThreadResume(workq->workers[idx]);
         }
     }
 
@@ -282,12 +464,17 @@ MDS_Err_t MDS_WorkQueueStop(MDS_WorkQueue_t *workq)
 
     MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
 
-    if (workq->thread != NULL) {
-        err = MDS_ThreadSuspend(workq->thread);
-        if (err == MDS_EOK) {
-            WORKQ_SkipListDrain(workq, &lock);
+    for (size_t idx = 0; idx < workq->nworkers; idx++) {
+        err = MDS_ThreadSuspend(workq->workers[idx]);
+        if (err == MDS_EAGAIN) {
+            err = MDS_EOK;  // idle worker already suspended
+        } else if (err != MDS_EOK) {
+            break;
         }
     }
+    if (err == MDS_EOK) {
+        WORKQ_SkipListDrain(workq, &lock);
+    }
 
     MDS_CriticalRestore(&(workq->spinlock), lock);
 
@@ -301,7 +488,9 @@ MDS_Tick_t MDS_WorkQueueNextTick(MDS_WorkQueue_t *workq)
     MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
 
     MDS_WorkNode_t *workn = WORKQ_SkipListPeek(workq);
-    if (workn != NULL) {
+    if (WORKQ_ReadyPeek(workq) != NULL) {
+        ticknext = MDS_ClockGetTickCount();
+    } else if (workn != NULL) {
         ticknext = workn->tickout;
     }
 
@@ -310,6 +499,20 @@ MDS_Tick_t MDS_WorkQueueNextTick(MDS_WorkQueue_t *workq)
     return (ticknext);
 }
 
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+void MDS_WorkQueueGetStats(MDS_WorkQueue_t *workq, MDS_WorkQueueStats_t *stats)
+{
+    MDS_ASSERT(workq != NULL);
+    MDS_ASSERT(stats != NULL);
+
+    MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
+
+    *stats = workq->stats;
+
+    MDS_CriticalRestore(&(workq->spinlock), lock);
+}
+#endif
+
 /* Work -------------------------------------------------------------------- */
 MDS_Err_t MDS_WorkNodeInit(MDS_WorkNode_t *workn, const char *name, MDS_WorkEntry_t entry,
                            MDS_WorkEntry_t stop, MDS_Arg_t *arg)
@@ -323,6 +526,7 @@ MDS_Err_t MDS_WorkNodeInit(MDS_WorkNode_t *workn, const char *name, MDS_WorkEntr
     MDS_Err_t err = MDS_ObjectInit(&(workn->object), MDS_OBJECT_TYPE_WORKNODE, name);
     if (err == MDS_EOK) {
         MDS_SkipListInitNode(workn->node, ARRAY_SIZE(workn->node));
+        workn->concurrency = 1;
         workn->entry = entry;
         workn->stop = stop;
         workn->arg = arg;
@@ -351,6 +555,7 @@ MDS_WorkNode_t *MDS_WorkNodeCreate(const char *name, MDS_WorkEntry_t entry, MDS_
                                                                MDS_OBJECT_TYPE_WORKNODE, name);
     if (workn != NULL) {
         MDS_SkipListInitNode(workn->node, ARRAY_SIZE(workn->node));
+        workn->concurrency = 1;
         workn->entry = entry;
         workn->stop = stop;
         workn->arg = arg;
@@ -384,26 +589,68 @@ MDS_Err_t MDS_WorkNodeSubmit(MDS_WorkQueue_t *workq, MDS_WorkNode_t *workn, MDS_
         return (MDS_EINVAL);
     }
 
-    MDS_Err_t err = MDS_EACCES;
+    if ((workn->queue != NULL) && (workn->queue != workq)) {
+        return (MDS_EBUSY);
+    }
+
+    bool reSchedule = false;
 
     MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
 
+    WORKQ_SkipListRemove(workn);
+    workn->pending = false;
     workn->tperiod = period.ticks;
-    WORKQ_SkipListInsert(workq, workn, duration.ticks);
     workn->queue = workq;
 
-    if ((workq->thread != NULL) && (workq->thread != MDS_KernelCurrentThread()) &&
-        (MDS_ThreadGetState(workq->thread) == MDS_THREAD_STATE_SUSPENDED)) {
-        err = MDS_ThreadResume(workq->thread);
+    if (duration.ticks == MDS_CLOCK_TICK_NO_WAIT) {
+#if (defined(CONFIG_MDS_KERNEL_STATS_ENABLE) && (CONFIG_MDS_KERNEL_STATS_ENABLE != 0))
+        workn->tickout = MDS_ClockGetTickCount();
+#endif
+        WORKQ_ReadyAppend(workq, workn);
+    } else {
+        WORKQ_SkipListInsert(workq, workn, duration.ticks);
+    }
+
+    if ((workq->nworkers > 0) &&
+        ((duration.ticks == MDS_CLOCK_TICK_NO_WAIT) || (WORKQ_SkipListPeek(workq) == workn))) {
+        reSchedule = (MDS_KernelWaitQueueResume(&(workq->queueIdle)) != NULL);
     }
 
     MDS_CriticalRestore(&(workq->spinlock), lock);
 
-    if (err == MDS_EOK) {
+    if (reSchedule) {
         MDS_KernelSchedulerCheck();
     }
 
-    return (err);
+    return (MDS_EOK);
+}
+
+MDS_Err_t MDS_WorkNodeSetConcurrency(MDS_WorkNode_t *workn, uint8_t concurrency)
+{
+    MDS_ASSERT(workn != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(workn->object)) == MDS_OBJECT_TYPE_WORKNODE);
+
+    if (concurrency == 0) {
+        return (MDS_EINVAL);
+    }
+
+    workn->concurrency = concurrency;
+
+    return (MDS_EOK);
+}
+
+MDS_Err_t MDS_WorkNodeSetSlack(MDS_WorkNode_t *workn, MDS_Timeout_t slack)
+{
+    MDS_ASSERT(workn != NULL);
+    MDS_ASSERT(MDS_ObjectGetType(&(workn->object)) == MDS_OBJECT_TYPE_WORKNODE);
+
+    if (slack.ticks >= MDS_CLOCK_TICK_TIMER_MAX) {
+        return (MDS_EINVAL);
+    }
+
+    workn->tslack = slack.ticks;
+
+    return (MDS_EOK);
 }
 
 MDS_Err_t MDS_WorkNodeCancle(MDS_WorkNode_t *workn)
@@ -411,12 +658,19 @@ MDS_Err_t MDS_WorkNodeCancle(MDS_WorkNode_t *workn)
     MDS_ASSERT(workn != NULL);
     MDS_ASSERT(MDS_ObjectGetType(&(workn->object)) == MDS_OBJECT_TYPE_WORKNODE);
 
-    if (workn->queue == NULL) {
+    MDS_WorkQueue_t *workq = workn->queue;
+    if (workq == NULL) {
         return (MDS_EAGAIN);
     }
 
+    MDS_Lock_t lock = MDS_CriticalLock(&(workq->spinlock));
+
     workn->queue = NULL;
+    workn->pending = false;
     WORKQ_SkipListRemove(workn);
+    WORKQ_RunDetach(workq, workn);
+
+    MDS_CriticalRestore(&(workq->spinlock), lock);
 
     if (workn->stop != NULL) {
         workn->stop(workn, workn->arg);
@@ -425,7 +679,7 @@ MDS_Err_t MDS_WorkNodeCancle(MDS_WorkNode_t *workn)
     return (MDS_EOK);
 }
 
-bool MDS_WorkNodeIsSumbit(MDS_WorkNode_t *workn)
+bool MDS_WorkNodeIsSubmit(const MDS_WorkNode_t *workn)
 {
     MDS_ASSERT(workn != NULL);
     MDS_ASSERT(MDS_ObjectGetType(&(workn->object)) == MDS_OBJECT_TYPE_WORKNODE);
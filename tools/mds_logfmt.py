@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+# Copyright (c) [2022] [pchom]
+# [MDS] is licensed under Mulan PSL v2.
+# You can use this software according to the terms and conditions of the Mulan PSL v2.
+# You may obtain a copy of Mulan PSL v2 at:
+#          http://license.coscl.org.cn/MulanPSL2
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+# EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+# MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+# See the Mulan PSL v2 for more details.
+"""
+Format MDS_LOG_CompressRead() records with the `.logfmt.` strings of the elf.
+
+    mds_logfmt.py firmware.elf log.bin
+"""
+import argparse
+import re
+import struct
+import sys
+
+LOG_COMPRESS_MAGIC = 0xD6
+LOG_COMPRESS_HEADER = struct.Struct("<III")
+LOG_LEVEL_NAMES = ["OFF", "FAT", "ERR", "WRN", "INF", "DBG"]
+
+LOG_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?"
+                      r"(hh|h|ll|l|L|z|j|t)?([diouxXeEfFgGaAcsp%])")
+
+
+class Elf:
+    def __init__(self, data):
+        if data[:4] != b"\x7fELF":
+            raise ValueError("not an elf file")
+        if data[5] != 1:
+            raise ValueError("only little endian elf is supported")
+
+        self.data = data
+        self.pointer = 8 if data[4] == 2 else 4
+        if self.pointer == 8:
+            shoff, = struct.unpack_from("<Q", data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x3A)
+            section = struct.Struct("<IIQQQQIIQQ")
+        else:
+            shoff, = struct.unpack_from("<I", data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+            section = struct.Struct("<IIIIIIIIII")
+
+        headers = [section.unpack_from(data, shoff + idx * shentsize) for idx in range(shnum)]
+        strtab = headers[shstrndx]
+
+        self.sections = []
+        for name, kind, flags, addr, offset, size in (h[:6] for h in headers):
+            end = data.index(b"\0", strtab[4] + name)
+            sname = data[strtab[4] + name:end].decode()
+            # SHF_ALLOC with file content, NOBITS carries no strings
+            if (flags & 0x2) and (kind != 8) and (addr != 0):
+                self.sections.append((sname, addr, offset, size))
+
+    def string(self, addr):
+        for _, base, offset, size in self.sections:
+            if base <= addr < base + size:
+                pos = offset + addr - base
+                end = self.data.index(b"\0", pos)
+                return self.data[pos:end].decode(errors="replace")
+        return None
+
+
+def log_arguments(elf, fmt, args):
+    long_size = elf.pointer
+    values = []
+    pieces = []
+    offset = 0
+    last = 0
+
+    def take(size, signed=False, real=False):
+        nonlocal offset
+        raw = args[offset:offset + size]
+        offset += size
+        if len(raw) != size:
+            raise ValueError("argument underflow")
+        if real:
+            return struct.unpack("<d", raw[:8])[0]
+        return int.from_bytes(raw, "little", signed=signed)
+
+    for match in LOG_SPEC.finditer(fmt):
+        flags, width, prec, length, conv = match.groups()
+        pieces.append(fmt[last:match.start()].replace("%", "%%"))
+        last = match.end()
+        if conv == "%":
+            pieces.append("%%")
+            continue
+
+        if width == "*":
+            width = str(take(4, signed=True))
+        if prec == "*":
+            prec = str(take(4, signed=True))
+        spec = "%" + flags + (width or "") + (("." + prec) if prec is not None else "")
+
+        if conv in "eEfFgGaA":
+            values.append(take(16 if ((length == "L") and (long_size == 8)) else 8, real=True))
+            pieces.append(spec + ("f" if conv in "aA" else conv))
+            continue
+
+        if conv in "sp":
+            addr = take(elf.pointer)
+            if conv == "p":
+                values.append("0x%x" % addr)
+            else:
+                text = elf.string(addr)
+                values.append(text if text is not None else "<0x%x>" % addr)
+            pieces.append(spec + "s")
+            continue
+
+        size = {"ll": 8, "l": long_size, "z": elf.pointer, "t": elf.pointer, "j": 8}.get(length, 4)
+        value = take(size, signed=(conv in "di"))
+        if conv == "c":
+            values.append(chr(value & 0xFF))
+            pieces.append(spec + "c")
+        else:
+            values.append(value)
+            pieces.append(spec + ("d" if conv in "diu" else conv))
+
+    pieces.append(fmt[last:].replace("%", "%%"))
+
+    return "".join(pieces) % tuple(values)
+
+
+def log_records(elf, data):
+    offset = 0
+    psn = None
+
+    while offset + LOG_COMPRESS_HEADER.size <= len(data):
+        word, address, timestamp = LOG_COMPRESS_HEADER.unpack_from(data, offset)
+        if (word & 0xFF) != LOG_COMPRESS_MAGIC:
+            offset += 1  # resync
+            continue
+
+        level, seq, size = (word >> 8) & 0xF, (word >> 12) & 0xFFF, word >> 24
+        args = data[offset + LOG_COMPRESS_HEADER.size:offset + LOG_COMPRESS_HEADER.size + size]
+        offset += LOG_COMPRESS_HEADER.size + size
+
+        if (psn is not None) and (((psn + 1) & 0xFFF) != seq):
+            yield "<%d records dropped>\n" % ((seq - psn - 1) & 0xFFF)
+        psn = seq
+
+        fmt = elf.string(address)
+        name = LOG_LEVEL_NAMES[level] if level < len(LOG_LEVEL_NAMES) else str(level)
+        if fmt is None:
+            yield "[%10u] %s <unknown format 0x%08x>\n" % (timestamp, name, address)
+            continue
+        try:
+            text = log_arguments(elf, fmt, args)
+        except (ValueError, TypeError) as err:
+            text = "<%s> %s" % (err, fmt)
+        yield "[%10u] %s %s" % (timestamp, name, text)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="firmware elf with .logfmt sections")
+    parser.add_argument("log", help="binary records read by MDS_LOG_CompressRead()")
+    args = parser.parse_args()
+
+    with open(args.elf, "rb") as f:
+        elf = Elf(f.read())
+    with open(args.log, "rb") as f:
+        data = f.read()
+
+    for line in log_records(elf, data):
+        sys.stdout.write(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+# Copyright (c) [2022] [pchom]
+# [MDS] is licensed under Mulan PSL v2.
+# You can use this software according to the terms and conditions of the Mulan PSL v2.
+# You may obtain a copy of Mulan PSL v2 at:
+#          http://license.coscl.org.cn/MulanPSL2
+# THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+# EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+# MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+# See the Mulan PSL v2 for more details.
+"""
+Decode a MDS_TraceDump() image into Chrome trace JSON (chrome://tracing, Perfetto).
+
+    mds_trace.py dump.bin -f 168000000 -o trace.json
+"""
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x5453444D
+TRACE_HEADER = struct.Struct("<IHBBII")
+
+# keep in order with MDS_KERNEL_Trace_t in inc/mds_sys.h
+TRACE_NAMES = [
+    "SCHEDULER_SWITCH",
+    "THREAD_INIT",
+    "THREAD_EXIT",
+    "THREAD_RESUME",
+    "THREAD_SUSPEND",
+    "TIMER_ENTER",
+    "TIMER_EXIT",
+    "TIMER_START",
+    "TIMER_STOP",
+    "MEMHEAP_INIT",
+    "MEMHEAP_ALLOC",
+    "MEMHEAP_FREE",
+    "MEMHEAP_REALLOC",
+    "SEMAPHORE_TRY_ACQUIRE",
+    "SEMAPHORE_HAS_ACQUIRE",
+    "SEMAPHORE_HAS_RELEASE",
+    "MUTEX_TRY_ACQUIRE",
+    "MUTEX_HAS_ACQUIRE",
+    "MUTEX_HAS_RELEASE",
+    "EVENT_TRY_ACQUIRE",
+    "EVENT_HAS_ACQUIRE",
+    "EVENT_HAS_SET",
+    "EVENT_HAS_CLR",
+    "MSGQUEUE_TRY_RECV",
+    "MSGQUEUE_HAS_RECV",
+    "MSGQUEUE_TRY_SEND",
+    "MSGQUEUE_HAS_SEND",
+    "MEMPOOL_TRY_ALLOC",
+    "MEMPOOL_HAS_ALLOC",
+    "MEMPOOL_HAS_FREE",
+]
+
+TRACE_ARGS = {"MEMHEAP": "size", "MEMPOOL": "blk"}
+
+
+def trace_records(data):
+    magic, version, record_size, pointer_size, count, lost = TRACE_HEADER.unpack_from(data, 0)
+    if magic != TRACE_MAGIC:
+        raise ValueError("bad magic 0x%08x" % magic)
+
+    pointer = {4: "I", 8: "Q"}[pointer_size]
+    record = struct.Struct("<IBBh" + pointer + pointer)
+    if record.size != record_size:
+        raise ValueError("record size %d mismatch %d" % (record_size, record.size))
+
+    offset = TRACE_HEADER.size
+    records = []
+    for _ in range(count):
+        records.append(record.unpack_from(data, offset))
+        offset += record_size
+
+    return version, lost, records
+
+
+def trace_unwrap(records):
+    # timestamp is 32-bit cycles, unwrap per cpu in record order then merge
+    last = {}
+    result = []
+    for timestamp, cpu, tid, err, obj, arg in records:
+        base, prev = last.get(cpu, (0, timestamp))
+        if timestamp < prev:
+            base += 1 << 32
+        last[cpu] = (base, timestamp)
+        result.append((base + timestamp, cpu, tid, err, obj, arg))
+
+    result.sort(key=lambda r: r[0])
+    origin = result[0][0] if result else 0
+
+    return [(r[0] - origin,) + r[1:] for r in result]
+
+
+def trace_chrome(records, freq):
+    scale = 1000000.0 / freq
+    events = []
+    current = {}
+    threads = set()
+
+    for cycle, cpu, tid, err, obj, arg in trace_unwrap(records):
+        ts = cycle * scale
+        name = TRACE_NAMES[tid] if tid < len(TRACE_NAMES) else ("TRACE_%d" % tid)
+
+        if name == "SCHEDULER_SWITCH":
+            if arg != 0:
+                events.append({"ph": "E", "pid": cpu, "tid": arg, "ts": ts})
+            events.append({"ph": "B", "pid": cpu, "tid": obj, "ts": ts, "name": "running"})
+            threads.add((cpu, obj))
+            current[cpu] = obj
+            continue
+
+        args = {"object": "0x%x" % obj, "err": err}
+        args[TRACE_ARGS.get(name.split("_")[0], "ticks")] = arg
+        events.append({"ph": "i", "s": "t", "pid": cpu, "tid": current.get(cpu, 0), "ts": ts,
+                       "name": name, "cat": name.split("_")[0].lower(), "args": args})
+
+    for cpu, thread in threads:
+        events.append({"ph": "M", "pid": cpu, "tid": thread, "name": "thread_name",
+                       "args": {"name": "thread 0x%x" % thread}})
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary image written by MDS_TraceDump()")
+    parser.add_argument("-f", "--freq", type=float, default=1000000.0,
+                        help="core cycle counter frequency in Hz")
+    parser.add_argument("-o", "--output", help="json output, default stdout")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as f:
+        version, lost, records = trace_records(f.read())
+    if lost != 0:
+        sys.stderr.write("warning: %d records lost before dump\n" % lost)
+
+    trace = trace_chrome(records, args.freq)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
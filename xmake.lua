@@ -50,6 +50,9 @@ target("kernel", function()
             target:add("defines", "CONFIG_MDS_LOG_FORMAT_SECTION=\"__TEXT__,logfmt_\"", {
                 public = true
             })
+            target:add("defines", "CONFIG_MDS_LOG_MODULE_SECTION=\"__TEXT__,logmod_\"", {
+                public = true
+            })
         end
     end)
 